@@ -18,7 +18,16 @@
 // Algorithms
 #include "algorithms/include/Algorithms.hpp"
 #include "algorithms/include/Delaunay.hpp"
+#include "algorithms/include/FortuneSweep.hpp"
 #include "algorithms/include/Voronoi.hpp"
 #include "algorithms/include/SegmentTree.hpp"
+#include "algorithms/include/RectangleSweep.hpp"
+#include "algorithms/include/BVH.hpp"
+#include "algorithms/include/RTree.hpp"
+#include "algorithms/include/SpatialHash.hpp"
+#include "algorithms/include/ConvexHull.hpp"
+#include "algorithms/include/Proximity.hpp"
+#include "algorithms/include/PolygonTriangulator.hpp"
+#include "algorithms/include/MeshIO.hpp"
 
 #endif // COMPGEOM_HPP
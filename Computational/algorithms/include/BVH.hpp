@@ -0,0 +1,127 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include "../../core/include/Point.hpp"
+#include "../../primitives/include/BoundingBox.hpp"
+#include "../../primitives/include/Polygon.hpp"
+#include "../../primitives/include/Segment.hpp"
+#include "../../primitives/include/Ray.hpp"
+#include "../../primitives/include/Triangle.hpp"
+#include "Algorithms.hpp"
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <thread>
+
+// Static bounding-volume hierarchy over BoundingBox<T, N>.
+// Built top-down with binned SAH, stored as a flat node array (children of an
+// internal node are always adjacent, left at `first`, right at `first + 1`).
+template <typename T, std::size_t N>
+class BVH {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+    static_assert(N > 0, "Dimension must be > 0");
+
+public:
+    using box_t = BoundingBox<T, N>;
+    using point_t = Point<T, N>;
+    using ray_t = Ray<T, N>;
+    using index_pair = std::pair<std::size_t, std::size_t>;
+
+    static constexpr std::size_t BIN_COUNT = 16;
+    static constexpr std::size_t MAX_LEAF_SIZE = 4;
+
+    struct Node {
+        box_t bounds;
+        std::size_t first = 0;  // First slot in indices_ (leaf) or left child index (internal)
+        std::size_t count = 0;  // Number of primitives, 0 for internal nodes
+
+        bool is_leaf() const { return count > 0; }
+    };
+
+    BVH() = default;
+    explicit BVH(const std::vector<box_t>& boxes);
+    explicit BVH(const std::vector<Polygon<T, N>>& polygons);
+
+    BVH(const BVH&) = default;
+    BVH& operator=(const BVH&) = default;
+    BVH(BVH&&) noexcept = default;
+    BVH& operator=(BVH&&) noexcept = default;
+
+    // Construction (primitive ids are positions in the input vector)
+    void build(const std::vector<box_t>& boxes);
+    void build(const std::vector<Polygon<T, N>>& polygons);  // Leaf bound is Polygon::boundingBox()
+
+    // Queries: ids of primitives whose boxes overlap / are hit by the ray.
+    // The overloads taking `out` append to it so callers can reuse the buffer.
+    std::vector<std::size_t> query_overlaps(const box_t& box) const;
+    void query_overlaps(const box_t& box, std::vector<std::size_t>& out) const;
+    std::vector<std::size_t> query_ray(const ray_t& ray) const;
+    void query_ray(const ray_t& ray, std::vector<std::size_t>& out) const;
+
+    // All pairs (i < j) of primitives whose boxes overlap
+    std::vector<index_pair> self_intersections() const;
+
+    // Nearest primitive to p. distance2(id) gives the squared distance from p
+    // to primitive id; nodes are visited nearer box first and skipped once
+    // their box is no closer than the best so far. `best` (squared) is an
+    // upper bound on entry and the found distance on exit; returns false if
+    // nothing lies within it.
+    template <typename Distance>
+    bool query_nearest(const point_t& p, Distance&& distance2, std::size_t& id, double& best) const;
+
+    // Accessors
+    const std::vector<Node>& nodes() const;
+    const box_t& bounds() const;
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t depth() const;
+
+    void clear();
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<std::size_t> indices_;  // Leaf slots -> primitive ids
+    std::vector<box_t> boxes_;          // Primitive bounds, indexed by id
+    std::vector<point_t> centroids_;
+
+    void build_nodes();
+    void subdivide(std::size_t node_idx);
+    void update_bounds(Node& node) const;
+    bool find_split(const Node& node, std::size_t& axis, T& split_pos) const;
+    bool ray_hits(const box_t& box, const point_t& origin, const point_t& dir) const;
+    void leaf_pairs(const Node& a, const Node& b, bool same, std::vector<index_pair>& out) const;
+    std::size_t depth_internal(std::size_t node_idx) const;
+
+    static T surface_area(const box_t& box);
+    static double box_distance2(const box_t& box, const point_t& p);
+};
+
+namespace algo {
+
+    // Broad phase through a BVH, narrow phase through algo::intersect
+    template <typename T>
+    std::vector<std::pair<std::size_t, std::size_t>> intersecting_pairs(const std::vector<Polygon<T, 2>>& polygons);
+
+    template <typename T>
+    std::vector<std::pair<std::size_t, std::size_t>> intersecting_pairs(const std::vector<Segment<T, 2>>& segments);
+
+    template <typename T>
+    struct MeshProjection {
+        Point<T, 2> point;      // Closest point on the mesh
+        double distance;
+        std::size_t triangle;   // Index into the triangle list
+    };
+
+    // Closest point on a triangle mesh for every query point: one BVH over
+    // the triangles, closest_point_on_triangle at the leaves, queries split
+    // across worker threads. Empty if there are no triangles.
+    template <typename T>
+    std::vector<MeshProjection<T>> closest_point_on_mesh(const std::vector<Point<T, 2>>& points,
+        const std::vector<Triangle<T, 2>>& triangles,
+        std::size_t threads = std::thread::hardware_concurrency());
+
+} // namespace algo
+
+#include "../src/BVH.tpp"
+
+#endif // BVH_HPP
@@ -0,0 +1,41 @@
+#ifndef CONVEXHULL_HPP
+#define CONVEXHULL_HPP
+
+#include "../../core/include/Point.hpp"
+#include "Algorithms.hpp"
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <thread>
+
+namespace algo {
+
+    // 2D hulls are returned counter-clockwise, starting at the lowest (x, y)
+    // point, without collinear vertices.
+
+    // Andrew's monotone chain, O(n log n)
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull_monotone(const std::vector<Point<T, 2>>& points);
+
+    // Akl-Toussaint heuristic: drops points strictly inside the octagon of extreme points
+    template <typename T>
+    std::vector<Point<T, 2>> akl_toussaint_filter(const std::vector<Point<T, 2>>& points);
+
+    // Pre-filter + monotone chain; the default entry point
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull(const std::vector<Point<T, 2>>& points);
+
+    // Chunks are hulled independently on worker threads, then the partial hulls are merged
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull_parallel(const std::vector<Point<T, 2>>& points,
+        std::size_t threads = std::thread::hardware_concurrency());
+
+    // 3D QuickHull: triangular faces as index triples into `points`, CCW seen from outside
+    template <typename T>
+    std::vector<std::array<std::size_t, 3>> convex_hull_3d(const std::vector<Point<T, 3>>& points);
+
+} // namespace algo
+
+#include "../src/ConvexHull.tpp"
+
+#endif // CONVEXHULL_HPP
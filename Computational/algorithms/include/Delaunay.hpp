@@ -4,18 +4,37 @@
 #include "../../core/include/Point.hpp"
 #include "../../primitives/include/Triangle.hpp"
 #include "../../primitives/include/Edge.hpp"
+#include "../../primitives/include/Segment.hpp"
 #include "../../primitives/include/BoundingBox.hpp"
+#include "ConvexHull.hpp"
+#include <array>
 #include <vector>
+#include <cstdint>
+#include <limits>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 
+// Incremental (Bowyer-Watson) Delaunay triangulation, optionally constrained.
+//
+// Internally the mesh is a set of CCW vertex index triples with per-edge
+// adjacency, enclosed by a super-triangle whose three vertices come first in
+// the vertex numbering (point i is vertex i + SUPER_VERTICES). Points are
+// located by walking the adjacency and inserted by re-triangulating the
+// cavity of triangles whose circumcircle contains them; constrained edges are
+// never crossed by a cavity. Removal re-triangulates the star of the vertex
+// with Delaunay ears, so updates only touch the affected neighbourhood. The
+// public triangle views exclude the triangles touching the super-triangle and
+// are rebuilt lazily after modifications.
 template <typename T>
 class Delaunay {
 public:
     using point_t = Point<T, 2>;
     using triangle_t = Triangle<T, 2>;
     using edge_t = Edge<T, 2>;
+    using index_triple = std::array<std::size_t, 3>;
     static constexpr double TOLERANCE = 1e-9;
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
     Delaunay() = default;
     explicit Delaunay(const std::vector<point_t>& points);
@@ -30,6 +49,33 @@ public:
     void insert(const std::vector<point_t>& points);
     void triangulate(const std::vector<point_t>& points);
 
+    // Local updates. remove() moves the last point into the freed index;
+    // move() keeps the index. Constraints ending at a removed point are
+    // dropped (the two halves of a split constraint are merged back). A move
+    // that stays inside the point's star is done with flips only.
+    //
+    // Coincident points share one mesh vertex: insert() merges a point into
+    // the vertex already at its position, and the repeated points given to
+    // triangulate() keep their indices as duplicates of that vertex. When the
+    // vertex is removed or moved away one of its duplicates takes its place
+    // (with its constraints); a point moved onto an occupied position becomes
+    // a duplicate of the vertex there.
+    bool remove(const point_t& p);
+    bool move(const point_t& from, const point_t& to);
+    bool move(std::size_t point, const point_t& to);  // Point index
+
+    // Points whose triangle fan changed in the last update (sorted)
+    const std::vector<std::size_t>& changed_points() const;
+
+    // Constrained edges: the segment is forced into the mesh by removing the
+    // triangles it crosses and re-triangulating the cavity on both sides.
+    // Missing endpoints are inserted; points lying on the segment split it.
+    void insert_constraint(const point_t& a, const point_t& b);
+    void insert_constraint(std::size_t a, std::size_t b);  // Point indices
+    void insert_constraints(const std::vector<Segment<T, 2>>& segments);
+    bool is_constrained(std::size_t a, std::size_t b) const;
+    std::vector<std::pair<std::size_t, std::size_t>> constraints() const;
+
     // Accessors
     const std::vector<triangle_t>& triangles() const;
     std::vector<edge_t> edges() const;
@@ -37,8 +83,28 @@ public:
     std::size_t triangle_count() const;
     std::size_t point_count() const;
 
+    // Indexed views, parallel to triangles(): point indices (CCW) and the
+    // triangle across the edge opposite each vertex (npos on the hull)
+    const std::vector<index_triple>& triangle_indices() const;
+    const std::vector<index_triple>& triangle_adjacency() const;
+
+    // Raw mesh exchange (serialization). Vertex ids are point indices followed
+    // by the three super-triangle corners; the triangles of triangles() come
+    // first and in the same order, then those touching the super-triangle.
+    void export_mesh(std::array<std::array<double, 2>, 3>& corners,
+                     std::vector<index_triple>& triangles,
+                     std::vector<index_triple>& adjacency) const;
+    void import_mesh(const std::vector<point_t>& points,
+                     const std::array<std::array<double, 2>, 3>& corners,
+                     const std::vector<index_triple>& triangles,
+                     const std::vector<index_triple>& adjacency,
+                     const std::vector<std::pair<std::size_t, std::size_t>>& constraints);
+
     // Queries
     const triangle_t* locate(const point_t& p) const;
+    std::size_t find(const point_t& p) const;  // Point index or npos
+    std::vector<std::size_t> vertex_neighbors(std::size_t point) const;  // CCW, npos past the hull
+    void vertex_neighbors(std::size_t point, std::vector<std::size_t>& ring) const;
     std::vector<std::size_t> neighbors(std::size_t tri_idx) const;
     bool is_valid() const;
 
@@ -49,21 +115,83 @@ public:
     void clear();
 
 private:
-    std::vector<triangle_t> triangles_;
+    static constexpr std::size_t SUPER_VERTICES = 3;
+
+    struct HalfEdge {
+        std::uint64_t key;
+        std::size_t triangle;
+        std::size_t slot;  // Index of the vertex opposite the edge
+    };
+
     std::vector<point_t> points_;
-    triangle_t super_triangle_;
-    bool has_super_triangle_ = false;
-    point_t super_vertices_[3];
 
-    // Bowyer-Watson helpers
+    // Mesh (vertex ids: super-triangle first, then points_)
+    std::vector<std::array<double, 2>> coords_;
+    std::vector<index_triple> tri_vertices_;   // [0] == npos marks a free slot
+    std::vector<index_triple> tri_neighbors_;
+    std::vector<std::size_t> free_triangles_;
+    std::vector<std::size_t> vertex_triangle_;  // One incident triangle, npos for duplicates
+    std::vector<std::size_t> duplicates_;       // Vertices sharing another's position
+    std::unordered_set<std::uint64_t> constraints_;
+    std::size_t last_triangle_ = npos;
+
+    std::vector<std::size_t> changed_;
+    bool record_changes_ = true;
+
+    // Scratch buffers, reused between updates
+    std::vector<std::size_t> mark_;
+    std::size_t epoch_ = 0;
+    std::vector<std::size_t> cavity_;
+    std::vector<index_triple> added_;
+    std::vector<std::pair<std::uint64_t, std::size_t>> boundary_;
+    std::vector<HalfEdge> half_edges_;
+    std::vector<std::size_t> left_chain_;
+    std::vector<std::size_t> right_chain_;
+    std::vector<std::size_t> ring_;
+    std::vector<std::size_t> detached_constraints_;
+    std::vector<std::size_t> added_slots_;
+
+    // Lazily rebuilt public views
+    mutable bool views_dirty_ = true;
+    mutable std::vector<triangle_t> triangles_;
+    mutable std::vector<index_triple> triangle_indices_;
+    mutable std::vector<index_triple> triangle_adjacency_;
+    mutable std::vector<std::size_t> slot_to_public_;
+
+    // Predicates on vertex ids
+    double orient(std::size_t a, std::size_t b, std::size_t c) const;
+    double orient(std::size_t a, std::size_t b, const std::array<double, 2>& p) const;
+    double in_circle(std::size_t a, std::size_t b, std::size_t c, std::size_t d) const;
+    static std::uint64_t edge_key(std::size_t a, std::size_t b);
+    static std::uint64_t undirected_key(std::size_t a, std::size_t b);
+
+    // Mesh maintenance
+    void rebuild_mesh();
     void create_super_triangle();
-    void remove_super_triangle();
-    std::vector<std::size_t> find_bad_triangles(const point_t& p) const;
-    std::vector<edge_t> find_polygon_hole(const std::vector<std::size_t>& bad_indices) const;
-    void remove_triangles(std::vector<std::size_t>& indices);
+    std::size_t add_triangle(const index_triple& vertices);
+    void replace_triangles(const std::vector<std::size_t>& removed, const std::vector<index_triple>& added);
+    std::size_t edge_slot(std::size_t t, std::size_t a, std::size_t b) const;
+    std::size_t locate_triangle(const std::array<double, 2>& p) const;
+    std::size_t insert_vertex(std::size_t v);
+    std::size_t insert_point(const point_t& p);
+    std::size_t find_vertex(const std::array<double, 2>& p) const;
+    void detach_vertex(std::size_t v);
+    bool shift_vertex(std::size_t v, const std::array<double, 2>& p);
+    void relabel_vertex(std::size_t from, std::size_t to);
+    void rename_in_star(std::size_t from, std::size_t to);
+    void collect_duplicates();
+    bool promote_duplicate(std::size_t v);
+    void flip(std::size_t t, std::size_t k);
+    void restore_delaunay(std::vector<std::size_t>& pending);
+    void finish_update();
+
+    // Constraint helpers
+    std::size_t resolve_vertex(std::size_t v) const;
+    bool has_edge(std::size_t a, std::size_t b) const;
+    void force_edge(std::size_t a, std::size_t b);
+    void fill_pseudo_polygon(std::size_t a, std::size_t b, const std::vector<std::size_t>& chain);
 
-    // Helper to check if a point is a super-triangle vertex
-    bool is_super_vertex(const point_t& p) const;
+    void refresh_views() const;
 };
 
 template <typename T>
@@ -0,0 +1,103 @@
+#ifndef FORTUNESWEEP_HPP
+#define FORTUNESWEEP_HPP
+
+#include "../../core/include/Point.hpp"
+#include <array>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+// Fortune's sweep-line construction of a Voronoi diagram, O(n log n).
+//
+// The sweep line moves towards +y. The beach line is a treap of parabolic
+// arcs, threaded left to right with prev/next links; it is searched by
+// evaluating the breakpoints at the current sweep position, so it needs no
+// key comparator. Circle events live in a binary heap and are cancelled
+// lazily. The output is the raw diagram: Voronoi vertices with the three
+// sites on their empty circle, and one record per Voronoi edge with the two
+// sites it separates. Repeated sites are skipped and get no edges.
+template <typename T>
+class FortuneSweep {
+public:
+    using point_t = Point<T, 2>;
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct Vertex {
+        std::array<double, 2> position;
+        std::array<std::size_t, 3> sites;   // CCW
+    };
+
+    // Seen from ends[0], ends[1] lies in direction rot90(right - left).
+    // An open end (npos) runs to infinity in that direction (or its reverse)
+    struct EdgeRecord {
+        std::size_t left;
+        std::size_t right;
+        std::array<std::size_t, 2> ends;
+    };
+
+    FortuneSweep() = default;
+
+    void run(const std::vector<point_t>& sites);
+
+    const std::vector<Vertex>& vertices() const;
+    const std::vector<EdgeRecord>& edges() const;
+    std::array<double, 2> direction(const EdgeRecord& edge, std::size_t end) const;  // Not normalised
+
+    void clear();
+
+private:
+    struct Arc {
+        std::size_t site;
+        std::uint32_t priority;
+        std::size_t parent = npos;  // Treap links
+        std::size_t left = npos;
+        std::size_t right = npos;
+        std::size_t prev = npos;    // Beach line order
+        std::size_t next = npos;
+        std::size_t edge = npos;    // Edge traced by the breakpoint with next
+        std::size_t end = 0;        // Which end of that edge the breakpoint traces
+        std::size_t event = npos;   // Pending circle event
+    };
+
+    struct CircleEvent {
+        double y;
+        std::array<double, 2> center;
+        std::size_t arc;
+        std::size_t id;
+
+        bool operator>(const CircleEvent& other) const { return y > other.y; }
+    };
+
+    std::vector<std::array<double, 2>> coords_;
+    std::vector<std::size_t> order_;
+    std::vector<Arc> arcs_;
+    std::size_t root_ = npos;
+    std::priority_queue<CircleEvent, std::vector<CircleEvent>, std::greater<CircleEvent>> events_;
+    std::size_t next_event_ = 0;
+    std::uint32_t seed_ = 2463534242u;
+    double sweep_ = 0.0;
+
+    std::vector<Vertex> vertices_;
+    std::vector<EdgeRecord> edges_;
+
+    // Beach line
+    double breakpoint(std::size_t left_site, std::size_t right_site) const;
+    std::size_t find_arc(double x) const;
+    std::size_t new_arc(std::size_t site);
+    void insert_after(std::size_t at, std::size_t arc);
+    void erase(std::size_t arc);
+    void rotate_up(std::size_t arc);
+
+    // Events
+    void site_event(std::size_t site);
+    void circle_event(const CircleEvent& event);
+    void check_circle(std::size_t arc);
+    std::size_t new_edge(std::size_t left, std::size_t right, std::size_t start);
+};
+
+#include "../src/FortuneSweep.tpp"
+
+#endif // FORTUNESWEEP_HPP
@@ -0,0 +1,131 @@
+#ifndef MESHIO_HPP
+#define MESHIO_HPP
+
+#include "Delaunay.hpp"
+#include "Voronoi.hpp"
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Versioned little-endian binary files for Delaunay and Voronoi meshes.
+//
+// Every section starts at an 8-byte aligned offset recorded in a fixed-size
+// header, so a file mapped into memory can be used in place: the views below
+// are plain pointers into the mapping, with no parsing and no copies. Index
+// arrays are uint32, coordinates are double regardless of T.
+//
+// Delaunay ("CGDT"): points (x, y), the three super-triangle corners, CCW
+// index triples, adjacency triples and constrained edges. Triangles below
+// triangle_count are the public ones (triangles() order); the ghost triangles
+// that touch the super-triangle follow, with vertex ids point_count + 0..2.
+// NO_INDEX marks an edge with nothing across it.
+//
+// Voronoi ("CGVR"): sites, then the cells as CSR offsets into one flat vertex
+// array and one flat neighbour array, then a bounded flag per cell.
+namespace algo {
+
+    constexpr std::uint32_t MESH_FORMAT_VERSION = 1;
+    constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    struct DelaunayFileHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t point_count;
+        std::uint64_t triangle_count;
+        std::uint64_t ghost_count;
+        std::uint64_t constraint_count;
+        std::uint64_t points_offset;
+        std::uint64_t corners_offset;
+        std::uint64_t triangles_offset;
+        std::uint64_t adjacency_offset;
+        std::uint64_t constraints_offset;
+        std::uint64_t file_size;
+    };
+
+    struct VoronoiFileHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t cell_count;
+        std::uint64_t vertex_count;
+        std::uint64_t neighbor_count;
+        std::uint64_t sites_offset;
+        std::uint64_t vertex_offsets_offset;
+        std::uint64_t vertices_offset;
+        std::uint64_t neighbor_offsets_offset;
+        std::uint64_t neighbors_offset;
+        std::uint64_t bounded_offset;
+        std::uint64_t file_size;
+    };
+
+    // Read-only file mapping (mmap on POSIX, a single read elsewhere)
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool is_open() const;
+        const unsigned char* data() const;
+        std::size_t size() const;
+
+    private:
+        const unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;
+        std::vector<unsigned char> buffer_;
+    };
+
+    // Zero-copy views; valid as long as the MappedFile stays open
+    struct DelaunayView {
+        std::size_t point_count = 0;
+        std::size_t triangle_count = 0;
+        std::size_t ghost_count = 0;
+        std::size_t constraint_count = 0;
+        const double* points = nullptr;           // 2 * point_count
+        const double* corners = nullptr;          // 6
+        const std::uint32_t* triangles = nullptr; // 3 * (triangle_count + ghost_count)
+        const std::uint32_t* adjacency = nullptr; // 3 * (triangle_count + ghost_count)
+        const std::uint32_t* constraints = nullptr; // 2 * constraint_count
+    };
+
+    struct VoronoiView {
+        std::size_t cell_count = 0;
+        std::size_t vertex_count = 0;
+        std::size_t neighbor_count = 0;
+        const double* sites = nullptr;                   // 2 * cell_count
+        const std::uint64_t* vertex_offsets = nullptr;   // cell_count + 1
+        const double* vertices = nullptr;                // 2 * vertex_count
+        const std::uint64_t* neighbor_offsets = nullptr; // cell_count + 1
+        const std::uint32_t* neighbors = nullptr;        // neighbor_count
+        const std::uint8_t* bounded = nullptr;           // cell_count
+    };
+
+    template <typename T>
+    bool save_delaunay(const Delaunay<T>& delaunay, const std::string& path);
+
+    template <typename T>
+    bool save_voronoi(const Voronoi<T>& voronoi, const std::string& path);
+
+    // Validate the header and section bounds, then point the view into the file
+    bool view_delaunay(const MappedFile& file, DelaunayView& view);
+    bool view_voronoi(const MappedFile& file, VoronoiView& view);
+
+    // Rebuild a live triangulation from a view without re-triangulating
+    template <typename T>
+    bool load_delaunay(const DelaunayView& view, Delaunay<T>& delaunay);
+
+} // namespace algo
+
+#include "../src/MeshIO.tpp"
+
+#endif // MESHIO_HPP
@@ -0,0 +1,111 @@
+#ifndef POLYGONTRIANGULATOR_HPP
+#define POLYGONTRIANGULATOR_HPP
+
+#include "../../core/include/Point.hpp"
+#include "../../primitives/include/Polygon.hpp"
+#include <array>
+#include <vector>
+#include <set>
+#include <utility>
+#include <cstddef>
+#include <limits>
+
+// Triangulates simple polygons (optionally with holes) along their edges.
+// Output triangles are CCW index triples into Polygon::vertices(); with holes,
+// hole vertices follow the outer ring in the order the holes were passed.
+//
+// Large inputs go through y-monotone decomposition (plane sweep) followed by
+// the linear monotone triangulation, O(n log n) overall. Hole-free polygons up
+// to EAR_CLIPPING_LIMIT vertices use ear clipping, which is faster there.
+// All working storage is kept between calls, so triangulating many polygons
+// with one instance does not reallocate once the buffers have grown.
+template <typename T>
+class PolygonTriangulator {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+public:
+    using point_t = Point<T, 2>;
+    using polygon_t = Polygon<T, 2>;
+    using triangle_t = std::array<std::size_t, 3>;
+
+    static constexpr std::size_t EAR_CLIPPING_LIMIT = 32;
+
+    PolygonTriangulator() = default;
+
+    // The sweep status refers back to its owner, so instances are not copyable
+    PolygonTriangulator(const PolygonTriangulator&) = delete;
+    PolygonTriangulator& operator=(const PolygonTriangulator&) = delete;
+
+    // Results stay valid until the next call
+    const std::vector<triangle_t>& triangulate(const polygon_t& outer);
+    const std::vector<triangle_t>& triangulate(const polygon_t& outer, const std::vector<polygon_t>& holes);
+    const std::vector<triangle_t>& triangulate_monotone(const polygon_t& outer,
+                                                        const std::vector<polygon_t>& holes = {});
+    const std::vector<triangle_t>& triangulate_ear_clipping(const polygon_t& outer);
+
+    const std::vector<triangle_t>& triangles() const;
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    enum class VertexType { Start, End, Split, Merge, Regular };
+
+    // Orders edges crossing the sweep line from left to right
+    struct EdgeOrder {
+        const PolygonTriangulator* owner;
+        bool operator()(std::size_t a, std::size_t b) const;
+    };
+
+    // Vertex rings (next_/prev_ keep the interior on the left)
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<std::size_t> next_;
+    std::vector<std::size_t> prev_;
+
+    // Sweep state
+    std::vector<std::size_t> order_;
+    std::vector<VertexType> types_;
+    std::vector<std::size_t> helper_;
+    std::vector<typename std::set<std::size_t, EdgeOrder>::iterator> status_pos_;
+    std::set<std::size_t, EdgeOrder> status_{EdgeOrder{this}};
+    double sweep_x_ = 0.0;
+    double sweep_y_ = 0.0;
+    double probe_x_ = 0.0;
+
+    // Monotone pieces
+    std::vector<std::pair<std::size_t, std::size_t>> diagonals_;
+    std::vector<std::size_t> adj_start_;
+    std::vector<std::size_t> adj_;
+    std::vector<bool> adj_used_;
+    std::vector<std::size_t> face_;
+    std::vector<std::size_t> sorted_face_;
+    std::vector<bool> left_chain_;
+    std::vector<std::size_t> stack_;
+
+    std::vector<triangle_t> triangles_;
+
+    void load(const polygon_t& outer, const std::vector<polygon_t>& holes);
+    void add_ring(const polygon_t& ring, bool counter_clockwise);
+    bool above(std::size_t a, std::size_t b) const;
+    double orient(std::size_t a, std::size_t b, std::size_t c) const;
+    double x_at(std::size_t edge, double y) const;
+    void emit(std::size_t a, std::size_t b, std::size_t c);
+
+    // Monotone decomposition
+    void classify_vertices();
+    void make_monotone();
+    std::size_t left_edge_of(std::size_t v);
+    void insert_edge(std::size_t edge, std::size_t helper);
+    void erase_edge(std::size_t edge);
+    void add_diagonal(std::size_t a, std::size_t b);
+    void build_faces();
+    void triangulate_monotone_face();
+
+    // Ear clipping
+    bool is_ear(std::size_t v) const;
+    void clip_ears();
+};
+
+#include "../src/PolygonTriangulator.tpp"
+
+#endif // POLYGONTRIANGULATOR_HPP
@@ -0,0 +1,45 @@
+#ifndef PROXIMITY_HPP
+#define PROXIMITY_HPP
+
+#include "../../core/include/Point.hpp"
+#include "Delaunay.hpp"
+#include "FortuneSweep.hpp"
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <limits>
+#include <thread>
+
+namespace algo {
+
+    // Bulk proximity queries over point sets. Results are indices into
+    // `points`; npos stands for "no such point" (fewer than two points).
+    // Repeated points are each other's nearest neighbours at distance 0.
+
+    constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    // Divide and conquer on the x-sorted points, merging by y on the way up,
+    // O(n log n). The x sort and the upper levels of the recursion run on
+    // worker threads. Returns (i, j) with i < j.
+    template <typename T>
+    std::pair<std::size_t, std::size_t> closest_pair(const std::vector<Point<T, 2>>& points,
+        std::size_t threads = std::thread::hardware_concurrency());
+
+    // Nearest neighbour of every point. Each point's nearest neighbour is one
+    // of its Delaunay neighbours, so once the Delaunay graph is known (from
+    // Fortune's sweep) every point only scans its own fan; the scans run on
+    // worker threads.
+    template <typename T>
+    std::vector<std::size_t> all_nearest_neighbors(const std::vector<Point<T, 2>>& points,
+        std::size_t threads = std::thread::hardware_concurrency());
+
+    // Same, on an existing triangulation of the points
+    template <typename T>
+    std::vector<std::size_t> all_nearest_neighbors(const Delaunay<T>& delaunay,
+        std::size_t threads = std::thread::hardware_concurrency());
+
+} // namespace algo
+
+#include "../src/Proximity.tpp"
+
+#endif // PROXIMITY_HPP
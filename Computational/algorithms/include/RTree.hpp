@@ -0,0 +1,108 @@
+#ifndef RTREE_HPP
+#define RTREE_HPP
+
+#include "../../core/include/Point.hpp"
+#include "../../primitives/include/BoundingBox.hpp"
+#include <array>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <limits>
+
+// Dynamic R*-tree keyed by BoundingBox<T, N>.
+// Insertion uses R* ChooseSubtree, forced reinsertion and the margin/overlap
+// split; removal condenses underfull nodes by reinsertion. bulk_load() packs
+// an initial dataset with Sort-Tile-Recursive instead of one-by-one inserts.
+template <typename T, std::size_t N>
+class RTree {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+    static_assert(N > 0, "Dimension must be > 0");
+
+public:
+    using box_t = BoundingBox<T, N>;
+    using point_t = Point<T, N>;
+    using item_t = std::pair<box_t, std::size_t>;
+
+    static constexpr std::size_t MAX_ENTRIES = 16;
+    static constexpr std::size_t MIN_ENTRIES = 6;     // ~40% of MAX_ENTRIES
+    static constexpr std::size_t REINSERT_COUNT = 5;  // ~30% of MAX_ENTRIES
+
+    RTree() = default;
+    explicit RTree(std::vector<item_t> items);
+
+    RTree(const RTree&) = default;
+    RTree& operator=(const RTree&) = default;
+    RTree(RTree&&) noexcept = default;
+    RTree& operator=(RTree&&) noexcept = default;
+
+    // Modification (id is an arbitrary user key, e.g. polygon index)
+    void insert(const box_t& box, std::size_t id);
+    bool remove(const box_t& box, std::size_t id);
+    void bulk_load(std::vector<item_t> items);  // Replaces current contents
+
+    // Queries
+    std::vector<std::size_t> query(const box_t& box) const;
+    void query(const box_t& box, std::vector<std::size_t>& out) const;
+    std::vector<std::size_t> nearest(const point_t& p, std::size_t k) const;  // Closest first
+
+    // Accessors
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t height() const;
+    box_t bounds() const;
+
+    void clear();
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct Entry {
+        box_t box;
+        std::size_t ref = 0;  // Child node index (internal) or user id (leaf)
+    };
+
+    struct Node {
+        std::size_t level = 0;  // 0 for leaves
+        std::size_t count = 0;
+        std::array<Entry, MAX_ENTRIES + 1> entries;  // One spare slot for overflow
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<std::size_t> free_nodes_;
+    std::size_t root_ = npos;
+    std::size_t size_ = 0;
+
+    // Node pool
+    std::size_t allocate_node(std::size_t level);
+    void release_node(std::size_t node_idx);
+
+    // Insertion helpers
+    void insert_entry(const Entry& entry, std::size_t level, std::vector<bool>& reinserted);
+    std::vector<std::size_t> choose_path(const box_t& box, std::size_t level) const;
+    std::vector<Entry> take_reinsert_entries(std::size_t node_idx);
+    std::size_t split(std::size_t node_idx);
+    void grow_root(std::size_t left, std::size_t right);
+
+    // Removal helpers
+    bool find_leaf(std::size_t node_idx, const box_t& box, std::size_t id, std::vector<std::size_t>& path) const;
+
+    // Bulk loading helpers
+    std::vector<Entry> str_pack(std::vector<Entry>& entries, std::size_t level);
+    void str_tile(typename std::vector<Entry>::iterator begin, typename std::vector<Entry>::iterator end,
+                  std::size_t dim, std::vector<std::pair<std::size_t, std::size_t>>& groups, std::size_t offset);
+
+    // Box helpers
+    box_t node_bounds(std::size_t node_idx) const;
+    void refresh_entry(std::size_t parent_idx, std::size_t child_idx);
+    static double volume(const box_t& box);
+    static double margin(const box_t& box);
+    static double overlap(const box_t& a, const box_t& b);
+    static double enlargement(const box_t& box, const box_t& add);
+    static double center(const box_t& box, std::size_t dim);
+    static double min_distance_squared(const box_t& box, const point_t& p);
+    static box_t merged(const box_t& a, const box_t& b);
+};
+
+#include "../src/RTree.tpp"
+
+#endif // RTREE_HPP
@@ -0,0 +1,69 @@
+#ifndef RECTANGLESWEEP_HPP
+#define RECTANGLESWEEP_HPP
+
+#include "../../core/include/Point.hpp"
+#include "../../primitives/include/BoundingBox.hpp"
+#include "SegmentTree.hpp"
+#include <vector>
+#include <cstddef>
+
+// Sweep-line measures over axis-aligned boxes, O(n log n).
+//
+// A vertical line sweeps the box edges in x order while a CoverSegmentTree
+// over the compressed y coordinates holds the boxes crossing it. The union
+// (Klee's measure problem) accumulates covered length times the distance to
+// the next event for the area; the perimeter adds the change of covered
+// length at each event (vertical edges) and two edges per covered run
+// between events (horizontal edges). Stabbing counts run the same sweep
+// offline with the query points as events. Buffers are kept between calls.
+template <typename T>
+class RectangleSweep {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+public:
+    using box_t = BoundingBox<T, 2>;
+    using point_t = Point<T, 2>;
+
+    struct UnionMeasure {
+        double area = 0;
+        double perimeter = 0;
+    };
+
+    RectangleSweep() = default;
+
+    // Area and perimeter of the union. Empty boxes and boxes of zero width
+    // or height add nothing.
+    UnionMeasure union_measure(const std::vector<box_t>& boxes);
+    double union_area(const std::vector<box_t>& boxes);
+    double union_perimeter(const std::vector<box_t>& boxes);
+
+    // Number of boxes containing each point (boundaries included)
+    std::vector<std::size_t> stabbing_counts(const std::vector<box_t>& boxes,
+                                             const std::vector<point_t>& points);
+
+    void clear();
+
+private:
+    // Adds sort before queries before removals at the same x
+    struct Event {
+        T x;
+        int kind;                // -1 add, 0 query, 1 remove
+        std::size_t first;       // Tree range, or query index
+        std::size_t last;
+
+        bool operator<(const Event& other) const {
+            return x < other.x || (x == other.x && kind < other.kind);
+        }
+    };
+
+    std::vector<T> ys_;
+    std::vector<Event> events_;
+    CoverSegmentTree<T> tree_;
+
+    void compress_ys(const std::vector<box_t>& boxes, bool closed);
+    std::size_t y_index(T y) const;
+};
+
+#include "../src/RectangleSweep.tpp"
+
+#endif // RECTANGLESWEEP_HPP
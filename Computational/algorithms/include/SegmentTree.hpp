@@ -7,6 +7,7 @@
 #include <type_traits>
 #include <limits>
 #include <memory>
+#include <cstdint>
 
 // Node structure for balanced binary tree
 template <typename T>
@@ -114,6 +115,63 @@ using MinSegmentTree = SegmentTree<T, MinOp<T>>;
 template <typename T>
 using MaxSegmentTree = SegmentTree<T, MaxOp<T>>;
 
+// Cover-count tree over weighted elementary intervals: the sweep status of
+// Klee's measure problem. add() leaves its count on the O(log n) nodes that
+// span the range and never pushes it down; a node with a positive count is
+// fully covered, otherwise it takes its measure from its children. The root
+// then gives the covered measure and the number of maximal covered runs.
+// Nodes live in a flat heap-ordered array (children of i at 2i and 2i + 1).
+template <typename T>
+class CoverSegmentTree {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    CoverSegmentTree() = default;
+    explicit CoverSegmentTree(size_type n);                  // Unit weights
+    explicit CoverSegmentTree(const std::vector<T>& weights);
+
+    // Build over elementary intervals with the given measures
+    void build(const std::vector<T>& weights);
+    void build(size_type n);
+
+    // Add delta to the cover count of intervals [left, right]. A removal
+    // must match an earlier add of the same range.
+    void add(size_type left, size_type right, int delta);
+
+    // Measure of the covered intervals and number of maximal covered runs
+    T covered() const;
+    size_type covered_runs() const;
+
+    // Number of ranges currently covering interval index (stabbing count)
+    long long count(size_type index) const;
+
+    size_type size() const;
+    bool empty() const;
+    void clear();
+
+private:
+    struct Node {
+        T full{};                   // Measure of the node's whole range
+        T covered{};
+        int count = 0;              // Ranges covering this node entirely
+        std::uint32_t runs = 0;
+        bool left_covered = false;  // First / last interval of the range covered
+        bool right_covered = false;
+    };
+
+    std::vector<Node> nodes_;
+    size_type n_ = 0;
+
+    void allocate();
+    void build_internal(const std::vector<T>* weights, size_type node, size_type left, size_type right);
+    void add_internal(size_type node, size_type left, size_type right,
+                      size_type from, size_type to, int delta);
+    void pull(size_type node, size_type left, size_type right);
+};
+
 #include "../src/SegmentTree.tpp"
 
 #endif // SEGMENTTREE_HPP
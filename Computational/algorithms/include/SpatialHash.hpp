@@ -0,0 +1,100 @@
+#ifndef SPATIALHASH_HPP
+#define SPATIALHASH_HPP
+
+#include "../../core/include/Point.hpp"
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+// Uniform grid broad phase for large sets of moving 2D points.
+// Cells are hashed into a power-of-two bucket table whose contents are stored
+// contiguously (CSR: bucket offsets + one id array, filled by counting sort).
+// A point that changes cell is chained into a flat overflow list instead of
+// moving it inside the CSR arrays; the grid is re-sorted once the overflow
+// grows past a fraction of the point count, which keeps move() O(1) amortized.
+template <typename T>
+class SpatialHashGrid {
+    static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+public:
+    using point_t = Point<T, 2>;
+    using index_pair = std::pair<std::size_t, std::size_t>;
+
+    explicit SpatialHashGrid(T cell_size);
+    SpatialHashGrid(T cell_size, const std::vector<point_t>& points);
+
+    SpatialHashGrid(const SpatialHashGrid&) = default;
+    SpatialHashGrid& operator=(const SpatialHashGrid&) = default;
+    SpatialHashGrid(SpatialHashGrid&&) noexcept = default;
+    SpatialHashGrid& operator=(SpatialHashGrid&&) noexcept = default;
+
+    // Construction (point ids are positions in the input vector)
+    void build(const std::vector<point_t>& points);
+    void update(const std::vector<point_t>& points);  // New positions for all ids, same count
+    std::size_t insert(const point_t& p);              // Returns the new id
+    void move(std::size_t id, const point_t& p);
+    void rebuild();
+
+    // Queries
+    std::vector<std::size_t> query_radius(const point_t& p, T radius) const;
+    void query_radius(const point_t& p, T radius, std::vector<std::size_t>& out) const;
+
+    // All pairs (i < j) closer than radius, split across threads by bucket range
+    std::vector<index_pair> pairs_within(T radius,
+        std::size_t threads = std::thread::hardware_concurrency()) const;
+
+    // Accessors
+    const point_t& position(std::size_t id) const;
+    std::size_t size() const;
+    T cell_size() const;
+
+    void clear();
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct CellKey {
+        std::int64_t x = 0;
+        std::int64_t y = 0;
+
+        bool operator==(const CellKey& other) const { return x == other.x && y == other.y; }
+        bool operator!=(const CellKey& other) const { return !(*this == other); }
+    };
+
+    struct OverflowNode {
+        std::size_t id;
+        std::size_t next;
+    };
+
+    T cell_size_;
+    double inv_cell_size_;
+
+    // Per-point state, indexed by id
+    std::vector<point_t> positions_;
+    std::vector<CellKey> cells_;
+    std::vector<std::size_t> overflow_slot_;  // Latest overflow node of the point, npos if it lives in the CSR
+
+    // Bucket table
+    std::size_t bucket_mask_ = 0;
+    std::vector<std::size_t> bucket_start_;  // CSR offsets, bucket_count + 1 entries
+    std::vector<std::size_t> bucket_items_;  // Ids sorted by bucket
+    std::vector<std::size_t> overflow_head_;
+    std::vector<OverflowNode> overflow_;
+
+    CellKey cell_of(const point_t& p) const;
+    std::size_t bucket_of(const CellKey& key) const;
+    void push_overflow(std::size_t id);
+
+    template <typename Visitor>
+    void for_each_in_cell(const CellKey& key, Visitor&& visit) const;
+
+    template <typename Visitor>
+    void for_each_in_bucket(std::size_t bucket, Visitor&& visit) const;
+};
+
+#include "../src/SpatialHash.tpp"
+
+#endif // SPATIALHASH_HPP
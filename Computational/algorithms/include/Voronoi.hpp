@@ -4,22 +4,60 @@
 #include "../../core/include/Point.hpp"
 #include "../../primitives/include/Edge.hpp"
 #include "Delaunay.hpp"
+#include "FortuneSweep.hpp"
 #include "../../primitives/include/BoundingBox.hpp"
 #include "../../primitives/include/Polygon.hpp"
 #include <vector>
-#include <unordered_map>
-
+#include <thread>
+
+// Voronoi diagram as the dual of a Delaunay triangulation.
+//
+// From SWEEP_THRESHOLD sites on, compute() builds the diagram directly with
+// Fortune's sweep instead (about twice as fast as triangulating and taking
+// the dual, see benchmarks/VoronoiBuilders.cpp); the triangulation is then
+// only computed when something needs it (local updates, relaxation,
+// delaunay()). Below the threshold both take a few milliseconds and the dual
+// keeps the triangulation ready for updates.
+//
+// Cell vertices and neighbour lists live in two flat arrays; each cell owns a
+// slice (offset, size, capacity). Vertex slices carry CLIP_SLACK spare slots,
+// enough for one box clip, so cells are clipped as they are written, in
+// parallel with only per-thread scratch buffers. A slice that outgrows its
+// capacity during an update moves to the end of the array; the arrays are
+// compacted once the abandoned space exceeds the live data.
+//
+// Clipping rebuilds the cells rather than cutting the stored ones: an
+// unbounded cell is first closed with its two outward bisector rays and the
+// box corners between their exit points, then clipped like a bounded one.
 template <typename T>
 class Voronoi {
 public:
     using point_t = Point<T, 2>;
     using edge_t = Edge<T, 2>;
     static constexpr double TOLERANCE = 1e-9;
+    static constexpr std::size_t CLIP_SLACK = 4;
+    static constexpr std::size_t SWEEP_THRESHOLD = 1024;
+
+    enum class Method { Automatic, DelaunayDual, FortuneSweep };
+
+    // Read-only window into the flat storage
+    template <typename U>
+    struct Range {
+        const U* first = nullptr;
+        std::size_t count = 0;
+
+        const U* begin() const { return first; }
+        const U* end() const { return first + count; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const U& operator[](std::size_t i) const { return first[i]; }
+    };
 
+    // Views are invalidated by any update or clipping
     struct Cell {
         point_t site;                           // Original input point (Delaunay vertex)
-        std::vector<point_t> vertices;          // CCW ordered Voronoi vertices
-        std::vector<std::size_t> neighbor_cells; // Adjacent cell indices
+        Range<point_t> vertices;                // CCW ordered Voronoi vertices
+        Range<std::size_t> neighbor_cells;      // Adjacent cell indices
         bool is_bounded = true;                 // False if cell extends to infinity
     };
 
@@ -34,11 +72,32 @@ public:
     Voronoi& operator=(Voronoi&&) noexcept = default;
 
     // Build from points or existing triangulation
-    void compute(const std::vector<point_t>& sites);
+    void compute(const std::vector<point_t>& sites, Method method = Method::Automatic);
     void compute(const Delaunay<T>& delaunay);
 
+    // Local updates: only the cells whose Delaunay fan changed are rebuilt
+    // (and re-clipped). remove() mirrors Delaunay: the last cell takes over
+    // the freed index.
+    void insert(const point_t& site);
+    bool remove(const point_t& site);
+    bool move(const point_t& from, const point_t& to);
+
+    // Lloyd relaxation towards a centroidal Voronoi tessellation. Each
+    // iteration moves every site to the centroid of its cell (one fused pass
+    // over the flat storage) and relocates it in the existing triangulation,
+    // rebuilding only the cells whose fan changed. Stops once no site moves
+    // farther than tolerance; returns the number of iterations run. Without
+    // clipping only bounded cells move; the bounds overload clips first.
+    std::size_t relax(std::size_t max_iterations, T tolerance = static_cast<T>(TOLERANCE));
+    std::size_t relax(const BoundingBox<T, 2>& bounds, std::size_t max_iterations,
+                      T tolerance = static_cast<T>(TOLERANCE));
+
+    // Worker threads for the whole-diagram passes (build, clipping, relaxation)
+    void set_thread_count(std::size_t threads);
+
     // Accessors
     const std::vector<Cell>& cells() const;
+    Cell cell(std::size_t idx) const;
     const std::vector<edge_t>& edges() const;
     const std::vector<point_t>& vertices() const;
     std::size_t cell_count() const;
@@ -60,25 +119,88 @@ public:
     void clear();
 
 private:
-    Delaunay<T> delaunay_;
-    std::vector<Cell> cells_;
-    std::vector<edge_t> edges_;
-    std::vector<point_t> vertices_;
+    struct Slice {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+        std::size_t capacity = 0;
+    };
+
+    struct Scratch {
+        std::vector<std::size_t> ring;
+        std::vector<point_t> polygon;
+        std::vector<point_t> clipped;
+        std::vector<std::size_t> runs;      // Open fan: end neighbours and circumcenter range per run
+        std::vector<std::size_t> overflow;  // Cells that outgrew their slice
+        double max_shift = 0;               // Squared, for relax()
+    };
+
+    // The triangulation is built lazily after a sweep; until then the sites
+    // are kept on their own
+    mutable Delaunay<T> delaunay_;
+    mutable std::vector<point_t> sites_;
+    mutable bool mesh_pending_ = false;
+    FortuneSweep<T> sweep_;
+    bool from_sweep_ = false;
+
     BoundingBox<T, 2> bounds_;
     bool is_clipped_ = false;
+    std::size_t threads_ = std::thread::hardware_concurrency();
+
+    // Flat cell storage
+    std::vector<point_t> cell_vertices_;
+    std::vector<std::size_t> cell_neighbors_;
+    std::vector<Slice> vertex_slices_;
+    std::vector<Slice> neighbor_slices_;
+    std::vector<unsigned char> bounded_;
+    std::size_t dead_vertices_ = 0;
+    std::size_t dead_neighbors_ = 0;
+    std::vector<Scratch> scratch_;  // One per worker, kept between passes
+
+    // Relaxation buffers, reused between iterations
+    std::vector<point_t> centroids_;
+    std::vector<std::size_t> dirty_;
+    std::vector<std::size_t> dirty_mark_;
+    std::size_t dirty_epoch_ = 0;
+
+    // Views, rebuilt on demand after updates (or when the storage moved)
+    mutable bool cells_dirty_ = true;
+    mutable std::vector<Cell> cells_;
+    mutable const point_t* cells_base_ = nullptr;
+    mutable bool edges_dirty_ = true;
+    mutable std::vector<edge_t> edges_;
+    mutable std::vector<point_t> vertices_;
 
     // Construction helpers
     void build_from_delaunay();
-    void compute_cell_vertices(std::size_t site_idx);
-    void order_cell_vertices_ccw(Cell& cell);
-    void identify_unbounded_cells();
+    void build_from_sweep();
+    const std::vector<point_t>& sites() const;
+    const Delaunay<T>& mesh() const;
+    void prepare_update();
+    bool gather_cell(std::size_t site_idx, Scratch& scratch) const;
+    void refill_cell(std::size_t site_idx, Scratch& scratch);
+    void update_cell(std::size_t site_idx);
+    void update_cells(const std::vector<std::size_t>& sites);
+    void compact();
+    void relocate_overflow();
+    void build_edges() const;
+    void build_cells() const;
+
+    template <typename U>
+    static void store_slice(std::vector<U>& flat, Slice& slice, const std::vector<U>& data,
+                            std::size_t slack, std::size_t& dead);
+
+    template <typename Fn>
+    void parallel_for(std::size_t n, Fn&& fn);
+
+    double compute_centroids();
 
     // Clipping helpers
+    BoundingBox<T, 2> closing_box(const point_t& site, const std::vector<point_t>& polygon) const;
+    void append_corners(std::vector<point_t>& polygon, const point_t& from, const point_t& to,
+                        const BoundingBox<T, 2>& box) const;
     point_t clip_infinite_edge(const edge_t& e, const BoundingBox<T, 2>& bounds) const;
-    void clip_cell(Cell& cell, const BoundingBox<T, 2>& bounds);
-
-    // Map from site point to cell index
-    std::unordered_map<std::size_t, std::size_t> site_to_cell_;
+    void clip_polygon(std::vector<point_t>& polygon, std::vector<point_t>& buffer,
+                      const BoundingBox<T, 2>& bounds) const;
 };
 
 template <typename T>
@@ -465,7 +465,7 @@ bool intersect(const Line<T, N>& CD, const Ray<T, N>& AB) noexcept {
         // General case: Sweep line algorithm
         const auto& edges1 = P1.edges();
         const auto& edges2 = P2.edges();
-        if (edges1.emtpy() || edges2.emtpy()) {
+        if (edges1.empty() || edges2.empty()) {
             return false;
         }
 
@@ -484,7 +484,7 @@ bool intersect(const Line<T, N>& CD, const Ray<T, N>& AB) noexcept {
 
                 return polyId < other.polyId;
             }
-        }
+        };
 
         std::vector<Event> events;
         events.reserve(edges1.size() * 2 + edges2.size() * 2);
@@ -527,15 +527,15 @@ bool intersect(const Line<T, N>& CD, const Ray<T, N>& AB) noexcept {
         };
 
         for (const auto& event : events) {
-            const auto& seg = (event.polyId == 0 ? edges1 : edges2)[event.segId];
+            const auto& seg = (event.polyId == 0 ? edges1 : edges2)[event.segIdx];
             if (event.isStart) {
-                active.insert({ev.segId, getY(seg, event.x), &seg});
+                active.insert({event.segIdx, getY(seg, event.x), &seg});
             }
             else {
-                active.erase({ev.segId, getY(seg, event.x), &seg});
+                active.erase({event.segIdx, getY(seg, event.x), &seg});
             }
 
-            auto it = active.find({event.segId, getY(seg, event.x), &seg});
+            auto it = active.find({event.segIdx, getY(seg, event.x), &seg});
             if (it == active.end()) {
                 continue;
             }
@@ -640,7 +640,7 @@ bool intersect(const Line<T, N>& CD, const Ray<T, N>& AB) noexcept {
     }
 
     template <typename T, std::size_t N>
-    bool intersect(const Line<T, N>& Line, const Polygon<T, N>& polygon) noexcept {
+    bool intersect(const Line<T, N>& line, const Polygon<T, N>& polygon) noexcept {
         static_assert(N == 2, "Polygon - Line intersection is defined only for 2D (N == 2)");
         for (const auto& edge : polygon.edges()) {
             if (intersect(edge, line)) {
@@ -0,0 +1,638 @@
+#ifndef BVH_TPP
+#define BVH_TPP
+
+#include "../include/BVH.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+template <typename T, std::size_t N>
+BVH<T, N>::BVH(const std::vector<box_t>& boxes) {
+    build(boxes);
+}
+
+template <typename T, std::size_t N>
+BVH<T, N>::BVH(const std::vector<Polygon<T, N>>& polygons) {
+    build(polygons);
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::build(const std::vector<box_t>& boxes) {
+    clear();
+    boxes_ = boxes;
+    build_nodes();
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::build(const std::vector<Polygon<T, N>>& polygons) {
+    clear();
+    boxes_.reserve(polygons.size());
+    for (const auto& polygon : polygons) {
+        boxes_.push_back(polygon.boundingBox());
+    }
+
+    build_nodes();
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::build_nodes() {
+    centroids_.resize(boxes_.size());
+    indices_.reserve(boxes_.size());
+    for (std::size_t i = 0; i < boxes_.size(); ++i) {
+        // Empty boxes can never overlap anything, keep them out of the tree
+        if (boxes_[i].empty()) {
+            continue;
+        }
+
+        centroids_[i] = boxes_[i].center();
+        indices_.push_back(i);
+    }
+
+    if (indices_.empty()) {
+        return;
+    }
+
+    // A binary tree with n leaves has at most 2n - 1 nodes
+    nodes_.reserve(2 * indices_.size() - 1);
+    nodes_.emplace_back();
+    nodes_[0].first = 0;
+    nodes_[0].count = indices_.size();
+    update_bounds(nodes_[0]);
+    subdivide(0);
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::update_bounds(Node& node) const {
+    node.bounds.reset();
+    for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+        node.bounds.expand(boxes_[indices_[i]]);
+    }
+}
+
+template <typename T, std::size_t N>
+T BVH<T, N>::surface_area(const box_t& box) {
+    if (box.empty()) {
+        return T{};
+    }
+
+    // Sum of the (N-1)-dimensional faces; proportional to the SAH hit probability
+    auto extent = box.size();
+    if constexpr (N == 1) {
+        return static_cast<T>(extent[0]);
+    }
+    else {
+        T area = T{};
+        for (std::size_t skip = 0; skip < N; ++skip) {
+            T face = static_cast<T>(1);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (i != skip) {
+                    face *= static_cast<T>(extent[i]);
+                }
+            }
+
+            area += face;
+        }
+
+        return area;
+    }
+}
+
+template <typename T, std::size_t N>
+bool BVH<T, N>::find_split(const Node& node, std::size_t& axis, T& split_pos) const {
+    struct Bin {
+        box_t bounds;
+        std::size_t count = 0;
+    };
+
+    // Bin on centroid bounds, not node bounds, so that large primitives do not
+    // squeeze all centroids into a single bin
+    box_t centroid_bounds;
+    for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+        centroid_bounds.expand(centroids_[indices_[i]]);
+    }
+
+    auto best_cost = std::numeric_limits<double>::max();
+    bool found = false;
+
+    for (std::size_t a = 0; a < N; ++a) {
+        auto lo = static_cast<double>(static_cast<T>(centroid_bounds.min()[a]));
+        auto hi = static_cast<double>(static_cast<T>(centroid_bounds.max()[a]));
+        if (!(hi > lo)) {
+            continue;  // All centroids coincide on this axis
+        }
+
+        std::array<Bin, BIN_COUNT> bins;
+        const double scale = BIN_COUNT / (hi - lo);
+        for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+            const std::size_t id = indices_[i];
+            auto c = static_cast<double>(static_cast<T>(centroids_[id][a]));
+            auto b = std::min(BIN_COUNT - 1, static_cast<std::size_t>((c - lo) * scale));
+            bins[b].count++;
+            bins[b].bounds.expand(boxes_[id]);
+        }
+
+        // Sweep from both sides to get the cost of every plane in O(BIN_COUNT)
+        std::array<double, BIN_COUNT - 1> left_area{};
+        std::array<std::size_t, BIN_COUNT - 1> left_count{};
+        box_t left_box;
+        std::size_t left_sum = 0;
+        for (std::size_t i = 0; i + 1 < BIN_COUNT; ++i) {
+            left_sum += bins[i].count;
+            left_count[i] = left_sum;
+            if (bins[i].count > 0) {
+                left_box.expand(bins[i].bounds);
+            }
+            left_area[i] = static_cast<double>(surface_area(left_box));
+        }
+
+        box_t right_box;
+        std::size_t right_sum = 0;
+        for (std::size_t i = BIN_COUNT - 1; i > 0; --i) {
+            right_sum += bins[i].count;
+            if (bins[i].count > 0) {
+                right_box.expand(bins[i].bounds);
+            }
+
+            const std::size_t plane = i - 1;
+            if (left_count[plane] == 0 || right_sum == 0) {
+                continue;
+            }
+
+            double cost = left_count[plane] * left_area[plane] +
+                          right_sum * static_cast<double>(surface_area(right_box));
+            if (cost < best_cost) {
+                best_cost = cost;
+                axis = a;
+                split_pos = static_cast<T>(lo + (plane + 1) / scale);
+                found = true;
+            }
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // Splitting must beat intersecting every primitive of the node directly
+    const double leaf_cost = node.count * static_cast<double>(surface_area(node.bounds));
+    return best_cost < leaf_cost || node.count > MAX_LEAF_SIZE;
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::subdivide(std::size_t node_idx) {
+    if (nodes_[node_idx].count <= MAX_LEAF_SIZE) {
+        return;
+    }
+
+    const std::size_t first = nodes_[node_idx].first;
+    const std::size_t count = nodes_[node_idx].count;
+    auto begin = indices_.begin() + first;
+    auto end = begin + count;
+
+    std::size_t axis = 0;
+    T split_pos{};
+    std::size_t left_count = 0;
+
+    if (find_split(nodes_[node_idx], axis, split_pos)) {
+        auto mid = std::partition(begin, end, [&](std::size_t id) {
+            return static_cast<T>(centroids_[id][axis]) < split_pos;
+        });
+        left_count = static_cast<std::size_t>(mid - begin);
+    }
+
+    // Degenerate split (coincident centroids or float round-off at the plane):
+    // fall back to a median split on the widest axis so depth stays O(log n)
+    if (left_count == 0 || left_count == count) {
+        auto extent = nodes_[node_idx].bounds.size();
+        axis = 0;
+        for (std::size_t a = 1; a < N; ++a) {
+            if (static_cast<T>(extent[a]) > static_cast<T>(extent[axis])) {
+                axis = a;
+            }
+        }
+
+        left_count = count / 2;
+        std::nth_element(begin, begin + left_count, end, [&](std::size_t lhs, std::size_t rhs) {
+            return static_cast<T>(centroids_[lhs][axis]) < static_cast<T>(centroids_[rhs][axis]);
+        });
+    }
+
+    const std::size_t left_idx = nodes_.size();
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+
+    nodes_[left_idx].first = first;
+    nodes_[left_idx].count = left_count;
+    nodes_[left_idx + 1].first = first + left_count;
+    nodes_[left_idx + 1].count = count - left_count;
+    update_bounds(nodes_[left_idx]);
+    update_bounds(nodes_[left_idx + 1]);
+
+    nodes_[node_idx].first = left_idx;
+    nodes_[node_idx].count = 0;
+
+    subdivide(left_idx);
+    subdivide(left_idx + 1);
+}
+
+template <typename T, std::size_t N>
+std::vector<std::size_t> BVH<T, N>::query_overlaps(const box_t& box) const {
+    std::vector<std::size_t> result;
+    query_overlaps(box, result);
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::query_overlaps(const box_t& box, std::vector<std::size_t>& out) const {
+    if (nodes_.empty() || box.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        if (!node.bounds.intersects(box)) {
+            continue;
+        }
+
+        if (node.is_leaf()) {
+            for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+                if (boxes_[indices_[i]].intersects(box)) {
+                    out.push_back(indices_[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+bool BVH<T, N>::ray_hits(const box_t& box, const point_t& origin, const point_t& dir) const {
+    // Slab test on the half-line origin + t * dir, t >= 0
+    double t_min = 0.0;
+    double t_max = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < N; ++i) {
+        auto o = static_cast<double>(static_cast<T>(origin[i]));
+        auto d = static_cast<double>(static_cast<T>(dir[i]));
+        auto lo = static_cast<double>(static_cast<T>(box.min()[i]));
+        auto hi = static_cast<double>(static_cast<T>(box.max()[i]));
+
+        if (std::abs(d) < coord_t<T>::TOLERANCE) {
+            if (o < lo || o > hi) {
+                return false;  // Parallel to the slab and outside it
+            }
+
+            continue;
+        }
+
+        auto t1 = (lo - o) / d;
+        auto t2 = (hi - o) / d;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+        if (t_min > t_max) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+std::vector<std::size_t> BVH<T, N>::query_ray(const ray_t& ray) const {
+    std::vector<std::size_t> result;
+    query_ray(ray, result);
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::query_ray(const ray_t& ray, std::vector<std::size_t>& out) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    const point_t& origin = ray.p1_;
+    const point_t dir = ray.p2_ - ray.p1_;
+
+    std::vector<std::size_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        if (!ray_hits(node.bounds, origin, dir)) {
+            continue;
+        }
+
+        if (node.is_leaf()) {
+            for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+                if (ray_hits(boxes_[indices_[i]], origin, dir)) {
+                    out.push_back(indices_[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+template <typename Distance>
+bool BVH<T, N>::query_nearest(const point_t& p, Distance&& distance2, std::size_t& id, double& best) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    bool found = false;
+    std::vector<std::pair<double, std::size_t>> stack;  // (box distance, node)
+    stack.reserve(64);
+    stack.emplace_back(box_distance2(nodes_[0].bounds, p), 0);
+    while (!stack.empty()) {
+        const auto [reach, node_idx] = stack.back();
+        stack.pop_back();
+        if (reach >= best) {
+            continue;
+        }
+
+        const Node& node = nodes_[node_idx];
+        if (node.is_leaf()) {
+            for (std::size_t i = node.first; i < node.first + node.count; ++i) {
+                if (box_distance2(boxes_[indices_[i]], p) >= best) {
+                    continue;
+                }
+
+                const double d = distance2(indices_[i]);
+                if (d < best) {
+                    best = d;
+                    id = indices_[i];
+                    found = true;
+                }
+            }
+        }
+        else {
+            // Nearer child on top of the stack
+            const double left = box_distance2(nodes_[node.first].bounds, p);
+            const double right = box_distance2(nodes_[node.first + 1].bounds, p);
+            if (left <= right) {
+                stack.emplace_back(right, node.first + 1);
+                stack.emplace_back(left, node.first);
+            }
+            else {
+                stack.emplace_back(left, node.first);
+                stack.emplace_back(right, node.first + 1);
+            }
+        }
+    }
+
+    return found;
+}
+
+template <typename T, std::size_t N>
+double BVH<T, N>::box_distance2(const box_t& box, const point_t& p) {
+    double d = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const double x = static_cast<double>(static_cast<T>(p[i]));
+        const double lo = static_cast<double>(static_cast<T>(box.min()[i]));
+        const double hi = static_cast<double>(static_cast<T>(box.max()[i]));
+        const double gap = x < lo ? lo - x : (x > hi ? x - hi : 0.0);
+        d += gap * gap;
+    }
+
+    return d;
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::leaf_pairs(const Node& a, const Node& b, bool same, std::vector<index_pair>& out) const {
+    for (std::size_t i = a.first; i < a.first + a.count; ++i) {
+        const std::size_t j_begin = same ? i + 1 : b.first;
+        for (std::size_t j = j_begin; j < b.first + b.count; ++j) {
+            const std::size_t id_a = indices_[i];
+            const std::size_t id_b = indices_[j];
+            if (boxes_[id_a].intersects(boxes_[id_b])) {
+                out.emplace_back(std::min(id_a, id_b), std::max(id_a, id_b));
+            }
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+std::vector<typename BVH<T, N>::index_pair> BVH<T, N>::self_intersections() const {
+    std::vector<index_pair> result;
+    if (nodes_.empty()) {
+        return result;
+    }
+
+    // Simultaneous descent of the tree against itself. A (node, node) entry
+    // stands for all pairs inside that subtree, (a, b) for pairs across a and b.
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.reserve(128);
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto [ia, ib] = stack.back();
+        stack.pop_back();
+
+        const Node& a = nodes_[ia];
+        const Node& b = nodes_[ib];
+
+        if (ia == ib) {
+            if (a.is_leaf()) {
+                leaf_pairs(a, a, true, result);
+            }
+            else {
+                stack.emplace_back(a.first, a.first);
+                stack.emplace_back(a.first + 1, a.first + 1);
+                stack.emplace_back(a.first, a.first + 1);
+            }
+
+            continue;
+        }
+
+        if (!a.bounds.intersects(b.bounds)) {
+            continue;
+        }
+
+        if (a.is_leaf() && b.is_leaf()) {
+            leaf_pairs(a, b, false, result);
+        }
+        else if (b.is_leaf() || (!a.is_leaf() && surface_area(a.bounds) >= surface_area(b.bounds))) {
+            // Descend into the larger internal node
+            stack.emplace_back(a.first, ib);
+            stack.emplace_back(a.first + 1, ib);
+        }
+        else {
+            stack.emplace_back(ia, b.first);
+            stack.emplace_back(ia, b.first + 1);
+        }
+    }
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+const std::vector<typename BVH<T, N>::Node>& BVH<T, N>::nodes() const {
+    return nodes_;
+}
+
+template <typename T, std::size_t N>
+const typename BVH<T, N>::box_t& BVH<T, N>::bounds() const {
+    static const box_t empty_box;
+    return nodes_.empty() ? empty_box : nodes_[0].bounds;
+}
+
+template <typename T, std::size_t N>
+std::size_t BVH<T, N>::size() const {
+    return boxes_.size();
+}
+
+template <typename T, std::size_t N>
+bool BVH<T, N>::empty() const {
+    return nodes_.empty();
+}
+
+template <typename T, std::size_t N>
+std::size_t BVH<T, N>::depth() const {
+    return nodes_.empty() ? 0 : depth_internal(0);
+}
+
+template <typename T, std::size_t N>
+std::size_t BVH<T, N>::depth_internal(std::size_t node_idx) const {
+    const Node& node = nodes_[node_idx];
+    if (node.is_leaf()) {
+        return 1;
+    }
+
+    return 1 + std::max(depth_internal(node.first), depth_internal(node.first + 1));
+}
+
+template <typename T, std::size_t N>
+void BVH<T, N>::clear() {
+    nodes_.clear();
+    indices_.clear();
+    boxes_.clear();
+    centroids_.clear();
+}
+
+namespace algo {
+
+/*
+================================================================================================================
+                                Batched Polygon / Segment Intersection
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<std::pair<std::size_t, std::size_t>> intersecting_pairs(const std::vector<Polygon<T, 2>>& polygons) {
+        BVH<T, 2> bvh(polygons);
+        auto candidates = bvh.self_intersections();
+
+        // Narrow phase: keep only the pairs whose polygons really intersect
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(),
+                [&polygons](const auto& pair) {
+                    return !intersect(polygons[pair.first], polygons[pair.second]);
+                }),
+            candidates.end());
+
+        return candidates;
+    }
+
+    template <typename T>
+    std::vector<std::pair<std::size_t, std::size_t>> intersecting_pairs(const std::vector<Segment<T, 2>>& segments) {
+        std::vector<BoundingBox<T, 2>> boxes(segments.size());
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            boxes[i].expand(segments[i].p1_);
+            boxes[i].expand(segments[i].p2_);
+        }
+
+        BVH<T, 2> bvh(boxes);
+        auto candidates = bvh.self_intersections();
+
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(),
+                [&segments](const auto& pair) {
+                    return !intersect(segments[pair.first], segments[pair.second]);
+                }),
+            candidates.end());
+
+        return candidates;
+    }
+
+/*
+================================================================================================================
+                                Closest Point on Mesh
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<MeshProjection<T>> closest_point_on_mesh(const std::vector<Point<T, 2>>& points,
+                                                         const std::vector<Triangle<T, 2>>& triangles,
+                                                         std::size_t threads) {
+        std::vector<MeshProjection<T>> result;
+        if (triangles.empty()) {
+            return result;
+        }
+
+        std::vector<BoundingBox<T, 2>> boxes(triangles.size());
+        for (std::size_t i = 0; i < triangles.size(); ++i) {
+            for (const auto& v : triangles[i].vertices) {
+                boxes[i].expand(v);
+            }
+        }
+        const BVH<T, 2> bvh(boxes);
+
+        result.resize(points.size());
+        auto project = [&](std::size_t first, std::size_t last) {
+            for (std::size_t q = first; q < last; ++q) {
+                const Point<T, 2>& p = points[q];
+                Point<T, 2> closest = p;
+                double best = std::numeric_limits<double>::infinity();
+                std::size_t id = 0;
+
+                // `best` still holds the previous best while a leaf is tested
+                auto distance2 = [&](std::size_t candidate) {
+                    const Point<T, 2> c = closest_point_on_triangle(p, triangles[candidate]);
+                    const double dx = static_cast<double>(static_cast<T>(c[0])) - static_cast<double>(static_cast<T>(p[0]));
+                    const double dy = static_cast<double>(static_cast<T>(c[1])) - static_cast<double>(static_cast<T>(p[1]));
+                    const double d = dx * dx + dy * dy;
+                    if (d < best) {
+                        closest = c;
+                    }
+
+                    return d;
+                };
+                bvh.query_nearest(p, distance2, id, best);
+                result[q] = {closest, std::sqrt(best), id};
+            }
+        };
+
+        threads = std::max<std::size_t>(1, std::min(threads, points.size() / 1024));
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) {
+            workers.emplace_back(project, points.size() * t / threads, points.size() * (t + 1) / threads);
+        }
+        project(0, points.size() / threads);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        return result;
+    }
+
+} // namespace algo
+
+#endif // BVH_TPP
@@ -0,0 +1,406 @@
+#ifndef CONVEXHULL_TPP
+#define CONVEXHULL_TPP
+
+#include "../include/ConvexHull.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <cstdint>
+
+namespace algo {
+
+/*
+================================================================================================================
+                                Monotone Chain (2D)
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull_monotone(const std::vector<Point<T, 2>>& points) {
+        if (points.size() < 3) {
+            return points;
+        }
+
+        std::vector<Point<T, 2>> sorted_points = points;
+        std::sort(sorted_points.begin(), sorted_points.end(),
+            [](const Point<T, 2>& a, const Point<T, 2>& b) {
+                if (static_cast<T>(a[0]) != static_cast<T>(b[0])) {
+                    return static_cast<T>(a[0]) < static_cast<T>(b[0]);
+                }
+
+                return static_cast<T>(a[1]) < static_cast<T>(b[1]);
+            });
+
+        std::vector<Point<T, 2>> hull;
+        hull.reserve(sorted_points.size() + 1);
+
+        // Build lower hull
+        for (const auto& p : sorted_points) {
+            while (hull.size() >= 2 && orientation(hull[hull.size() - 2], hull[hull.size() - 1], p) <= 0) {
+                hull.pop_back();
+            }
+
+            hull.push_back(p);
+        }
+
+        // Build upper hull
+        const std::size_t lower_size = hull.size() + 1;
+        for (auto it = sorted_points.rbegin() + 1; it != sorted_points.rend(); ++it) {
+            while (hull.size() >= lower_size && orientation(hull[hull.size() - 2], hull[hull.size() - 1], *it) <= 0) {
+                hull.pop_back();
+            }
+
+            hull.push_back(*it);
+        }
+
+        hull.pop_back();  // Last point is the first one again
+        return hull;
+    }
+
+/*
+================================================================================================================
+                                Akl-Toussaint Pre-filter
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<Point<T, 2>> akl_toussaint_filter(const std::vector<Point<T, 2>>& points) {
+        if (points.size() < 9) {
+            return points;
+        }
+
+        // Extreme points along the eight octagon directions, listed counter-clockwise
+        constexpr int dirs[8][2] = {{-1, 0}, {-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}};
+        std::array<std::size_t, 8> extreme{};
+        std::array<T, 8> best;
+        best.fill(std::numeric_limits<T>::lowest());
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const auto x = static_cast<T>(points[i][0]);
+            const auto y = static_cast<T>(points[i][1]);
+            for (std::size_t d = 0; d < 8; ++d) {
+                const T value = dirs[d][0] * x + dirs[d][1] * y;
+                if (value > best[d]) {
+                    best[d] = value;
+                    extreme[d] = i;
+                }
+            }
+        }
+
+        std::vector<Point<T, 2>> octagon;
+        for (std::size_t d = 0; d < 8; ++d) {
+            const auto& p = points[extreme[d]];
+            if (octagon.empty() || (p != octagon.back() && p != octagon.front())) {
+                octagon.push_back(p);
+            }
+        }
+
+        if (octagon.size() < 3) {
+            return points;
+        }
+
+        // Keep everything that is not strictly inside the octagon
+        std::vector<Point<T, 2>> survivors;
+        survivors.reserve(points.size() / 4 + octagon.size());
+        for (const auto& p : points) {
+            bool inside = true;
+            for (std::size_t i = 0; i < octagon.size() && inside; ++i) {
+                inside = orientation(octagon[i], octagon[(i + 1) % octagon.size()], p) > 0;
+            }
+
+            if (!inside) {
+                survivors.push_back(p);
+            }
+        }
+
+        return survivors;
+    }
+
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull(const std::vector<Point<T, 2>>& points) {
+        // The filter only pays off once sorting dominates
+        if (points.size() < 256) {
+            return convex_hull_monotone(points);
+        }
+
+        return convex_hull_monotone(akl_toussaint_filter(points));
+    }
+
+/*
+================================================================================================================
+                                Parallel Divide and Merge (2D)
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<Point<T, 2>> convex_hull_parallel(const std::vector<Point<T, 2>>& points, std::size_t threads) {
+        threads = std::max<std::size_t>(1, threads);
+        if (threads == 1 || points.size() < 4096 * threads) {
+            return convex_hull(points);
+        }
+
+        // Hull of a union is the hull of the partial hulls
+        std::vector<std::vector<Point<T, 2>>> partial(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&points, &partial, t, threads] {
+                const std::size_t first = points.size() * t / threads;
+                const std::size_t last = points.size() * (t + 1) / threads;
+                std::vector<Point<T, 2>> chunk(points.begin() + first, points.begin() + last);
+                partial[t] = convex_hull(chunk);
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::vector<Point<T, 2>> merged;
+        for (const auto& hull : partial) {
+            merged.insert(merged.end(), hull.begin(), hull.end());
+        }
+
+        return convex_hull_monotone(merged);
+    }
+
+/*
+================================================================================================================
+                                QuickHull (3D)
+================================================================================================================
+*/
+    template <typename T>
+    std::vector<std::array<std::size_t, 3>> convex_hull_3d(const std::vector<Point<T, 3>>& points) {
+        using vec3 = std::array<double, 3>;
+
+        struct Face {
+            std::array<std::size_t, 3> v;
+            vec3 normal;
+            double offset;
+            std::vector<std::size_t> outside;
+            bool alive = true;
+        };
+
+        std::vector<std::array<std::size_t, 3>> result;
+        const std::size_t n = points.size();
+        if (n < 4) {
+            return result;
+        }
+
+        std::vector<vec3> P(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                P[i][k] = static_cast<double>(static_cast<T>(points[i][k]));
+            }
+        }
+
+        auto sub = [](const vec3& a, const vec3& b) { return vec3{a[0] - b[0], a[1] - b[1], a[2] - b[2]}; };
+        auto dot = [](const vec3& a, const vec3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+        auto cross = [](const vec3& a, const vec3& b) {
+            return vec3{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        };
+
+        // Initial simplex from extreme points
+        std::size_t axis = 0;
+        std::array<std::size_t, 3> lo{}, hi{};
+        for (std::size_t i = 1; i < n; ++i) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                if (P[i][k] < P[lo[k]][k]) lo[k] = i;
+                if (P[i][k] > P[hi[k]][k]) hi[k] = i;
+            }
+        }
+
+        for (std::size_t k = 1; k < 3; ++k) {
+            if (P[hi[k]][k] - P[lo[k]][k] > P[hi[axis]][axis] - P[lo[axis]][axis]) {
+                axis = k;
+            }
+        }
+
+        const double extent = P[hi[axis]][axis] - P[lo[axis]][axis];
+        const double eps = coord_t<T>::TOLERANCE * std::max(1.0, extent);
+        if (extent <= eps) {
+            return result;
+        }
+
+        const std::size_t i0 = lo[axis];
+        const std::size_t i1 = hi[axis];
+
+        std::size_t i2 = n;
+        double best = eps;
+        const vec3 line = sub(P[i1], P[i0]);
+        for (std::size_t i = 0; i < n; ++i) {
+            const vec3 c = cross(line, sub(P[i], P[i0]));
+            const double d = std::sqrt(dot(c, c));
+            if (d > best) {
+                best = d;
+                i2 = i;
+            }
+        }
+
+        if (i2 == n) {
+            return result;  // All points collinear
+        }
+
+        std::size_t i3 = n;
+        best = eps;
+        vec3 base = cross(line, sub(P[i2], P[i0]));
+        const double base_len = std::sqrt(dot(base, base));
+        for (std::size_t i = 0; i < n; ++i) {
+            const double d = std::abs(dot(base, sub(P[i], P[i0]))) / base_len;
+            if (d > best) {
+                best = d;
+                i3 = i;
+            }
+        }
+
+        if (i3 == n) {
+            return result;  // All points coplanar
+        }
+
+        std::vector<Face> faces;
+        std::unordered_map<std::uint64_t, std::size_t> edge_face;  // Directed edge -> face on its left
+        auto edge_key = [](std::size_t u, std::size_t v) {
+            return (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint64_t>(v);
+        };
+
+        auto distance = [&](const Face& f, std::size_t p) { return dot(f.normal, P[p]) - f.offset; };
+
+        auto add_face = [&](std::size_t a, std::size_t b, std::size_t c) {
+            Face f;
+            f.v = {a, b, c};
+            f.normal = cross(sub(P[b], P[a]), sub(P[c], P[a]));
+            const double len = std::sqrt(dot(f.normal, f.normal));
+            for (auto& x : f.normal) {
+                x /= len;
+            }
+            f.offset = dot(f.normal, P[a]);
+
+            const std::size_t idx = faces.size();
+            edge_face[edge_key(a, b)] = idx;
+            edge_face[edge_key(b, c)] = idx;
+            edge_face[edge_key(c, a)] = idx;
+            faces.push_back(std::move(f));
+
+            return idx;
+        };
+
+        // Orient the tetrahedron so every face normal points away from the fourth vertex
+        if (dot(base, sub(P[i3], P[i0])) > 0) {
+            add_face(i0, i2, i1);
+            add_face(i0, i1, i3);
+            add_face(i1, i2, i3);
+            add_face(i2, i0, i3);
+        }
+        else {
+            add_face(i0, i1, i2);
+            add_face(i0, i3, i1);
+            add_face(i1, i3, i2);
+            add_face(i2, i3, i0);
+        }
+
+        auto assign = [&](const std::vector<std::size_t>& candidates, const std::vector<std::size_t>& targets) {
+            for (std::size_t p : candidates) {
+                std::size_t best_face = faces.size();
+                double best_dist = eps;
+                for (std::size_t f : targets) {
+                    const double d = distance(faces[f], p);
+                    if (d > best_dist) {
+                        best_dist = d;
+                        best_face = f;
+                    }
+                }
+
+                if (best_face != faces.size()) {
+                    faces[best_face].outside.push_back(p);
+                }
+            }
+        };
+
+        {
+            std::vector<std::size_t> all;
+            all.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (i != i0 && i != i1 && i != i2 && i != i3) {
+                    all.push_back(i);
+                }
+            }
+
+            assign(all, {0, 1, 2, 3});
+        }
+
+        std::vector<std::size_t> pending = {0, 1, 2, 3};
+        while (!pending.empty()) {
+            const std::size_t current = pending.back();
+            pending.pop_back();
+            if (!faces[current].alive || faces[current].outside.empty()) {
+                continue;
+            }
+
+            // Eye point: farthest point in the outside set
+            std::size_t eye = faces[current].outside[0];
+            double eye_dist = distance(faces[current], eye);
+            for (std::size_t p : faces[current].outside) {
+                const double d = distance(faces[current], p);
+                if (d > eye_dist) {
+                    eye_dist = d;
+                    eye = p;
+                }
+            }
+
+            // Flood the visible region and collect its horizon
+            std::vector<std::size_t> visible = {current};
+            std::vector<std::pair<std::size_t, std::size_t>> horizon;
+            faces[current].alive = false;
+            for (std::size_t vi = 0; vi < visible.size(); ++vi) {
+                const Face& f = faces[visible[vi]];
+                for (std::size_t e = 0; e < 3; ++e) {
+                    const std::size_t u = f.v[e];
+                    const std::size_t v = f.v[(e + 1) % 3];
+                    const std::size_t neighbor = edge_face[edge_key(v, u)];
+                    if (!faces[neighbor].alive) {
+                        continue;
+                    }
+
+                    if (distance(faces[neighbor], eye) > eps) {
+                        faces[neighbor].alive = false;
+                        visible.push_back(neighbor);
+                    }
+                    else {
+                        horizon.emplace_back(u, v);
+                    }
+                }
+            }
+
+            std::vector<std::size_t> orphans;
+            for (std::size_t f : visible) {
+                for (std::size_t p : faces[f].outside) {
+                    if (p != eye) {
+                        orphans.push_back(p);
+                    }
+                }
+
+                faces[f].outside.clear();
+                faces[f].outside.shrink_to_fit();
+            }
+
+            // Cone from the eye to the horizon
+            std::vector<std::size_t> created;
+            created.reserve(horizon.size());
+            for (const auto& [u, v] : horizon) {
+                created.push_back(add_face(u, v, eye));
+            }
+
+            assign(orphans, created);
+            pending.insert(pending.end(), created.begin(), created.end());
+        }
+
+        for (const auto& f : faces) {
+            if (f.alive) {
+                result.push_back(f.v);
+            }
+        }
+
+        return result;
+    }
+
+} // namespace algo
+
+#endif // CONVEXHULL_TPP
@@ -1,231 +1,1270 @@
 #ifndef DELAUNAY_TPP
 #define DELAUNAY_TPP
 
-#include "Delaunay.hpp"
+#include "../include/Delaunay.hpp"
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 template <typename T>
 Delaunay<T>::Delaunay(const std::vector<point_t>& points) {
     triangulate(points);
 }
 
+/*
+================================================================================================================
+                                Predicates
+================================================================================================================
+*/
+template <typename T>
+double Delaunay<T>::orient(std::size_t a, std::size_t b, std::size_t c) const {
+    return orient(a, b, coords_[c]);
+}
+
+template <typename T>
+double Delaunay<T>::orient(std::size_t a, std::size_t b, const std::array<double, 2>& p) const {
+    const auto& pa = coords_[a];
+    const auto& pb = coords_[b];
+
+    return (pb[0] - pa[0]) * (p[1] - pa[1]) - (pb[1] - pa[1]) * (p[0] - pa[0]);
+}
+
+template <typename T>
+double Delaunay<T>::in_circle(std::size_t a, std::size_t b, std::size_t c, std::size_t d) const {
+    // Positive when d lies strictly inside the circumcircle of the CCW triangle abc
+    const auto& pd = coords_[d];
+    const double adx = coords_[a][0] - pd[0], ady = coords_[a][1] - pd[1];
+    const double bdx = coords_[b][0] - pd[0], bdy = coords_[b][1] - pd[1];
+    const double cdx = coords_[c][0] - pd[0], cdy = coords_[c][1] - pd[1];
+
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+    const double det = alift * (bdx * cdy - cdx * bdy)
+                     + blift * (cdx * ady - adx * cdy)
+                     + clift * (adx * bdy - bdx * ady);
+
+    // Below the rounding error the four points count as cocircular; otherwise
+    // both diagonals of a cyclic quad can test positive and flips never end
+    const double permanent = alift * (std::abs(bdx * cdy) + std::abs(cdx * bdy))
+                           + blift * (std::abs(cdx * ady) + std::abs(adx * cdy))
+                           + clift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+
+    return std::abs(det) <= 1e-12 * permanent ? 0 : det;
+}
+
+template <typename T>
+std::uint64_t Delaunay<T>::edge_key(std::size_t a, std::size_t b) {
+    return (static_cast<std::uint64_t>(a) << 32) | static_cast<std::uint64_t>(b);
+}
+
+template <typename T>
+std::uint64_t Delaunay<T>::undirected_key(std::size_t a, std::size_t b) {
+    return a < b ? edge_key(a, b) : edge_key(b, a);
+}
+
+/*
+================================================================================================================
+                                Mesh Maintenance
+================================================================================================================
+*/
 template <typename T>
 void Delaunay<T>::triangulate(const std::vector<point_t>& points) {
     clear();
-    if (points.size() < 3) {
-        points_ = points;
+    points_ = points;
+    rebuild_mesh();
+}
+
+template <typename T>
+void Delaunay<T>::finish_update() {
+    std::sort(changed_.begin(), changed_.end());
+    changed_.erase(std::unique(changed_.begin(), changed_.end()), changed_.end());
+}
+
+template <typename T>
+void Delaunay<T>::rebuild_mesh() {
+    const std::size_t n = points_.size();
+    tri_vertices_.clear();
+    tri_neighbors_.clear();
+    free_triangles_.clear();
+    mark_.clear();
+    last_triangle_ = npos;
+    views_dirty_ = true;
+
+    coords_.resize(SUPER_VERTICES + n);
+    for (std::size_t i = 0; i < n; ++i) {
+        coords_[SUPER_VERTICES + i] = {static_cast<double>(static_cast<T>(points_[i][0])),
+                                       static_cast<double>(static_cast<T>(points_[i][1]))};
+    }
+    vertex_triangle_.assign(SUPER_VERTICES + n, npos);
+    duplicates_.clear();
+
+    // Every point is affected; skip the per-triangle bookkeeping
+    changed_.resize(n);
+    std::iota(changed_.begin(), changed_.end(), std::size_t{0});
+    if (n == 0) {
         return;
     }
 
-    points_ = points;
     create_super_triangle();
-    for (const auto& p : points_) {
-        insert(p);
+    record_changes_ = false;
+
+    // Insert along a Hilbert curve so each walk starts next to its target
+    double min_x = coords_[SUPER_VERTICES][0], max_x = min_x;
+    double min_y = coords_[SUPER_VERTICES][1], max_y = min_y;
+    for (std::size_t v = SUPER_VERTICES; v < coords_.size(); ++v) {
+        min_x = std::min(min_x, coords_[v][0]);
+        max_x = std::max(max_x, coords_[v][0]);
+        min_y = std::min(min_y, coords_[v][1]);
+        max_y = std::max(max_y, coords_[v][1]);
+    }
+
+    const double scale = 65535.0 / std::max({max_x - min_x, max_y - min_y, TOLERANCE});
+    std::vector<std::pair<std::uint64_t, std::size_t>> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto x = static_cast<std::uint32_t>((coords_[SUPER_VERTICES + i][0] - min_x) * scale);
+        auto y = static_cast<std::uint32_t>((coords_[SUPER_VERTICES + i][1] - min_y) * scale);
+        std::uint64_t d = 0;
+        for (std::uint32_t s = 1u << 15; s > 0; s >>= 1) {
+            const std::uint32_t rx = (x & s) ? 1 : 0;
+            const std::uint32_t ry = (y & s) ? 1 : 0;
+            d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = 65535 - x;
+                    y = 65535 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        order[i] = {d, i};
     }
+    std::sort(order.begin(), order.end());
 
-    remove_super_triangle();
+    for (const auto& entry : order) {
+        insert_vertex(SUPER_VERTICES + entry.second);
+    }
+    collect_duplicates();
+
+    // Constraints survive a rebuild (vertex ids are stable, but of coincident
+    // points another one may have become the mesh vertex)
+    const auto saved = std::move(constraints_);
+    constraints_.clear();
+    for (std::uint64_t key : saved) {
+        force_edge(resolve_vertex(static_cast<std::size_t>(key >> 32)), resolve_vertex(static_cast<std::size_t>(key & 0xFFFFFFFFULL)));
+    }
+    record_changes_ = true;
 }
 
 template <typename T>
 void Delaunay<T>::create_super_triangle() {
-    if (points_.empty()) {
-        return;
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+    for (std::size_t v = SUPER_VERTICES; v < coords_.size(); ++v) {
+        min_x = std::min(min_x, coords_[v][0]);
+        min_y = std::min(min_y, coords_[v][1]);
+        max_x = std::max(max_x, coords_[v][0]);
+        max_y = std::max(max_y, coords_[v][1]);
+    }
+
+    auto delta_max = std::max(max_x - min_x, max_y - min_y);
+    if (delta_max <= 0) {
+        delta_max = 1;
+    }
+    const auto mid_x = (min_x + max_x) / 2;
+    const auto mid_y = (min_y + max_y) / 2;
+
+    // Super-triangle enclosing all points, counter-clockwise
+    coords_[0] = {mid_x - 20 * delta_max, mid_y - delta_max};
+    coords_[1] = {mid_x + 20 * delta_max, mid_y - delta_max};
+    coords_[2] = {mid_x, mid_y + 20 * delta_max};
+
+    last_triangle_ = add_triangle({0, 1, 2});
+    for (std::size_t v = 0; v < SUPER_VERTICES; ++v) {
+        vertex_triangle_[v] = last_triangle_;
     }
+}
 
-    // Find bounding box
-    auto min_x = std::numeric_limits<T>::max();
-    auto min_y = std::numeric_limits<T>::max();
-    auto max_x = std::numeric_limits<T>::lowest();
-    auto max_y = std::numeric_limits<T>::lowest();
-    for (const auto& p : points_) {
-        auto px = static_cast<T>(p[0]);
-        auto py = static_cast<T>(p[1]);
-        min_x = std::min(min_x, px);
-        min_y = std::min(min_y, py);
-        max_x = std::max(max_x, px);
-        max_y = std::max(max_y, py);
+template <typename T>
+std::size_t Delaunay<T>::add_triangle(const index_triple& vertices) {
+    std::size_t t;
+    if (!free_triangles_.empty()) {
+        t = free_triangles_.back();
+        free_triangles_.pop_back();
+    }
+    else {
+        t = tri_vertices_.size();
+        tri_vertices_.emplace_back();
+        tri_neighbors_.emplace_back();
+        mark_.push_back(0);
     }
 
-    auto dx = max_x - min_x;
-    auto dy = max_y - min_y;
-    auto delta_max = std::max(dx, dy);
-    auto mid_x = (min_x + max_x) / 2;
-    auto mid_y = (min_y + max_y) / 2;
+    tri_vertices_[t] = vertices;
+    tri_neighbors_[t] = {npos, npos, npos};
+    mark_[t] = 0;
+
+    return t;
+}
 
-    // Create super-triangle that encompasses all points (3x the bounding box)
-    super_vertices_[0] = point_t{mid_x - 20 * delta_max, mid_y - delta_max};
-    super_vertices_[1] = point_t{mid_x, mid_y + 20 * delta_max};
-    super_vertices_[2] = point_t{mid_x + 20 * delta_max, mid_y - delta_max};
+template <typename T>
+std::size_t Delaunay<T>::edge_slot(std::size_t t, std::size_t a, std::size_t b) const {
+    const auto& v = tri_vertices_[t];
+    for (std::size_t k = 0; k < 3; ++k) {
+        if (v[(k + 1) % 3] == a && v[(k + 2) % 3] == b) {
+            return k;
+        }
+    }
 
-    super_triangle_ = triangle_t(super_vertices_[0], super_vertices_[1], super_vertices_[2]);
-    triangles_.push_back(super_triangle_);
-    has_super_triangle_ = true;
+    return npos;
 }
 
 template <typename T>
-void Delaunay<T>::remove_super_triangle() {
-    if (!has_super_triangle_) {
-        return;
+void Delaunay<T>::replace_triangles(const std::vector<std::size_t>& removed, const std::vector<index_triple>& added) {
+    // The region's outer edges remember the triangle beyond them
+    ++epoch_;
+    for (std::size_t t : removed) {
+        mark_[t] = epoch_;
     }
 
-    // Remove all triangles that share a vertex with the super-triangle
-    triangles_.erase(
-        std::remove_if(triangles_.begin(), triangles_.end(),
-            [this](const triangle_t& tri) {
-                for (int i = 0; i < 3; ++i) {
-                    if (is_super_vertex(tri.vertices[i])) {
-                        return true;
-                    }
+    boundary_.clear();
+    for (std::size_t t : removed) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[t][k];
+            if (n == npos || mark_[n] != epoch_) {
+                boundary_.emplace_back(edge_key(tri_vertices_[t][(k + 1) % 3], tri_vertices_[t][(k + 2) % 3]), n);
+            }
+        }
+    }
+
+    for (std::size_t t : removed) {
+        tri_vertices_[t][0] = npos;
+        free_triangles_.push_back(t);
+    }
+
+    half_edges_.clear();
+    added_slots_.clear();
+    for (const auto& tri : added) {
+        const std::size_t t = add_triangle(tri);
+        added_slots_.push_back(t);
+        for (std::size_t k = 0; k < 3; ++k) {
+            half_edges_.push_back(HalfEdge{edge_key(tri[(k + 1) % 3], tri[(k + 2) % 3]), t, k});
+            vertex_triangle_[tri[k]] = t;
+            if (record_changes_ && tri[k] >= SUPER_VERTICES) {
+                changed_.push_back(tri[k] - SUPER_VERTICES);
+            }
+        }
+        last_triangle_ = t;
+    }
+
+    // Stitch: a half-edge pairs with its twin inside the region or with the boundary
+    auto by_key = [](const HalfEdge& a, const HalfEdge& b) { return a.key < b.key; };
+    std::sort(half_edges_.begin(), half_edges_.end(), by_key);
+    std::sort(boundary_.begin(), boundary_.end());
+
+    for (const auto& he : half_edges_) {
+        const auto a = static_cast<std::size_t>(he.key >> 32);
+        const auto b = static_cast<std::size_t>(he.key & 0xFFFFFFFFULL);
+
+        const HalfEdge probe{edge_key(b, a), 0, 0};
+        auto twin = std::lower_bound(half_edges_.begin(), half_edges_.end(), probe, by_key);
+        if (twin != half_edges_.end() && twin->key == probe.key) {
+            tri_neighbors_[he.triangle][he.slot] = twin->triangle;
+            continue;
+        }
+
+        auto outer = std::lower_bound(boundary_.begin(), boundary_.end(), std::make_pair(he.key, std::size_t{0}));
+        if (outer != boundary_.end() && outer->first == he.key) {
+            const std::size_t n = outer->second;
+            tri_neighbors_[he.triangle][he.slot] = n;
+            if (n != npos) {
+                tri_neighbors_[n][edge_slot(n, b, a)] = he.triangle;
+            }
+        }
+    }
+
+    views_dirty_ = true;
+}
+
+template <typename T>
+std::size_t Delaunay<T>::locate_triangle(const std::array<double, 2>& p) const {
+    if (tri_vertices_.empty()) {
+        return npos;
+    }
+
+    std::size_t t = last_triangle_;
+    if (t >= tri_vertices_.size() || tri_vertices_[t][0] == npos) {
+        t = 0;
+        while (t < tri_vertices_.size() && tri_vertices_[t][0] == npos) {
+            ++t;
+        }
+    }
+
+    // Visibility walk; rotating the first tested edge keeps it from cycling
+    // around constrained edges
+    const std::size_t limit = tri_vertices_.size() + 16;
+    for (std::size_t step = 0; step < limit; ++step) {
+        bool moved = false;
+        for (std::size_t j = 0; j < 3; ++j) {
+            const std::size_t k = (j + step) % 3;
+            const auto& v = tri_vertices_[t];
+            if (orient(v[(k + 1) % 3], v[(k + 2) % 3], p) < 0) {
+                t = tri_neighbors_[t][k];
+                if (t == npos) {
+                    return npos;  // Outside the super-triangle
                 }
+                moved = true;
+                break;
+            }
+        }
 
-                return false;
-            }),
+        if (!moved) {
+            return t;
+        }
+    }
 
-            triangles_.end()
-        );
+    for (t = 0; t < tri_vertices_.size(); ++t) {
+        const auto& v = tri_vertices_[t];
+        if (v[0] != npos && orient(v[0], v[1], p) >= 0 && orient(v[1], v[2], p) >= 0 && orient(v[2], v[0], p) >= 0) {
+            return t;
+        }
+    }
 
-    has_super_triangle_ = false;
+    return npos;
 }
 
 template <typename T>
-bool Delaunay<T>::is_super_vertex(const point_t& p) const {
-    for (int i = 0; i < 3; ++i) {
-        if (p == super_vertices_[i]) {
-            return true;
+std::size_t Delaunay<T>::insert_vertex(std::size_t v) {
+    const auto& p = coords_[v];
+    const std::size_t start = locate_triangle(p);
+    if (start == npos) {
+        return npos;
+    }
+
+    for (std::size_t u : tri_vertices_[start]) {
+        if (std::abs(coords_[u][0] - p[0]) <= TOLERANCE && std::abs(coords_[u][1] - p[1]) <= TOLERANCE) {
+            return u;
         }
     }
 
-    return false;
+    // Cavity: triangles whose circumcircle contains p, grown across
+    // unconstrained edges (a constrained edge is only crossed by a point on it)
+    ++epoch_;
+    cavity_.clear();
+    cavity_.push_back(start);
+    mark_[start] = epoch_;
+
+    std::vector<std::uint64_t> split;
+    for (std::size_t i = 0; i < cavity_.size(); ++i) {
+        const std::size_t c = cavity_[i];
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[c][k];
+            if (n == npos || mark_[n] == epoch_) {
+                continue;
+            }
+
+            const std::size_t a = tri_vertices_[c][(k + 1) % 3];
+            const std::size_t b = tri_vertices_[c][(k + 2) % 3];
+            const bool constrained = !constraints_.empty() && constraints_.count(undirected_key(a, b));
+            if (constrained && orient(a, b, p) != 0) {
+                continue;
+            }
+
+            const auto& w = tri_vertices_[n];
+            if (in_circle(w[0], w[1], w[2], v) > 0) {
+                mark_[n] = epoch_;
+                cavity_.push_back(n);
+                if (constrained) {
+                    split.push_back(undirected_key(a, b));
+                }
+            }
+        }
+    }
+
+    // Round-off can leave p on or behind a boundary edge; the cavity must
+    // stay star-shaped around p
+    for (std::size_t i = 0; i < cavity_.size(); ++i) {
+        const std::size_t c = cavity_[i];
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[c][k];
+            if (n == npos || mark_[n] == epoch_) {
+                continue;
+            }
+
+            const std::size_t a = tri_vertices_[c][(k + 1) % 3];
+            const std::size_t b = tri_vertices_[c][(k + 2) % 3];
+            if (orient(a, b, p) <= 0 && !constraints_.count(undirected_key(a, b))) {
+                mark_[n] = epoch_;
+                cavity_.push_back(n);
+            }
+        }
+    }
+
+    added_.clear();
+    for (std::size_t c : cavity_) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[c][k];
+            if (n == npos || mark_[n] != epoch_) {
+                added_.push_back({tri_vertices_[c][(k + 1) % 3], tri_vertices_[c][(k + 2) % 3], v});
+            }
+        }
+    }
+
+    replace_triangles(cavity_, added_);
+
+    for (std::uint64_t key : split) {
+        constraints_.erase(key);
+        constraints_.insert(undirected_key(static_cast<std::size_t>(key >> 32), v));
+        constraints_.insert(undirected_key(v, static_cast<std::size_t>(key & 0xFFFFFFFFULL)));
+    }
+
+    return v;
 }
 
 template <typename T>
-void Delaunay<T>::insert(const point_t& p) {
-    // Find all triangles whose circumcircle contains the point
-    std::vector<std::size_t> bad_triangles = find_bad_triangles(p);
-    if (bad_triangles.empty()) {
-        return;
+std::size_t Delaunay<T>::insert_point(const point_t& p) {
+    if (tri_vertices_.empty()) {
+        points_.push_back(p);
+        rebuild_mesh();
+
+        return SUPER_VERTICES + points_.size() - 1;
     }
 
-    // Find the polygon hole boundary
-    std::vector<edge_t> polygon = find_polygon_hole(bad_triangles);
+    const std::size_t v = coords_.size();
+    points_.push_back(p);
+    coords_.push_back({static_cast<double>(static_cast<T>(p[0])), static_cast<double>(static_cast<T>(p[1]))});
+    vertex_triangle_.push_back(npos);
 
-    // Remove bad triangles
-    remove_triangles(bad_triangles);
+    const std::size_t id = insert_vertex(v);
+    if (id == v) {
+        return v;
+    }
 
-    // Create new triangles from the point to each edge of the polygon
-    for (const auto& edge : polygon) {
-        triangles_.emplace_back(p, edge.p1_, edge.p2_);
+    points_.pop_back();
+    coords_.pop_back();
+    vertex_triangle_.pop_back();
+    if (id != npos) {
+        return id;  // Duplicate of an existing point
     }
+
+    // Outside the super-triangle: grow it and start over
+    points_.push_back(p);
+    rebuild_mesh();
+
+    return SUPER_VERTICES + points_.size() - 1;
+}
+
+template <typename T>
+void Delaunay<T>::insert(const point_t& p) {
+    changed_.clear();
+    insert_point(p);
+    finish_update();
 }
 
 template <typename T>
 void Delaunay<T>::insert(const std::vector<point_t>& points) {
+    changed_.clear();
     for (const auto& p : points) {
-        // Add to points list if not already present
-        bool found = false;
-        for (const auto& existing : points_) {
-            if (existing == p) {
-                found = true;
+        insert_point(p);
+    }
+    finish_update();
+}
+
+/*
+================================================================================================================
+                                Removal / Relocation
+================================================================================================================
+*/
+template <typename T>
+std::size_t Delaunay<T>::find_vertex(const std::array<double, 2>& p) const {
+    const std::size_t t = locate_triangle(p);
+    if (t == npos) {
+        return npos;
+    }
+
+    for (std::size_t u : tri_vertices_[t]) {
+        if (u >= SUPER_VERTICES && std::abs(coords_[u][0] - p[0]) <= TOLERANCE && std::abs(coords_[u][1] - p[1]) <= TOLERANCE) {
+            return u;
+        }
+    }
+
+    return npos;
+}
+
+template <typename T>
+std::size_t Delaunay<T>::find(const point_t& p) const {
+    const std::size_t v = find_vertex({static_cast<double>(static_cast<T>(p[0])), static_cast<double>(static_cast<T>(p[1]))});
+
+    return v == npos ? npos : v - SUPER_VERTICES;
+}
+
+template <typename T>
+void Delaunay<T>::detach_vertex(std::size_t v) {
+    // Star of v: incident triangles and the CCW ring of its neighbours
+    cavity_.clear();
+    ring_.clear();
+    detached_constraints_.clear();
+
+    const std::size_t first = vertex_triangle_[v];
+    std::size_t t = first;
+    do {
+        const auto& w = tri_vertices_[t];
+        const std::size_t i = w[0] == v ? 0 : (w[1] == v ? 1 : 2);
+        cavity_.push_back(t);
+        ring_.push_back(w[(i + 1) % 3]);
+        t = tri_neighbors_[t][(i + 1) % 3];
+    } while (t != first && t != npos);
+
+    for (std::size_t r : ring_) {
+        if (constraints_.erase(undirected_key(v, r))) {
+            detached_constraints_.push_back(r);
+        }
+    }
+
+    // Clip ears of the (star-shaped) ring whose circumcircle holds no other
+    // ring vertex; these are exactly the Delaunay triangles of the hole. Near
+    // constraints such an ear may not exist, then any proper ear is taken.
+    added_.clear();
+    while (ring_.size() > 3) {
+        const std::size_t k = ring_.size();
+        std::size_t ear = npos;
+        std::size_t proper = npos;
+        for (std::size_t i = 0; i < k && ear == npos; ++i) {
+            const std::size_t a = ring_[(i + k - 1) % k];
+            const std::size_t b = ring_[i];
+            const std::size_t c = ring_[(i + 1) % k];
+            if (orient(a, b, c) <= 0) {
+                continue;
+            }
+
+            bool empty = true;
+            bool inside = false;
+            for (std::size_t j = 0; j < k && !inside; ++j) {
+                const std::size_t d = ring_[j];
+                if (d == a || d == b || d == c) {
+                    continue;
+                }
+                if (orient(a, b, d) >= 0 && orient(b, c, d) >= 0 && orient(c, a, d) >= 0) {
+                    inside = true;
+                }
+                else if (in_circle(a, b, c, d) > 0) {
+                    empty = false;
+                }
+            }
+
+            if (!inside && empty) {
+                ear = i;
+            }
+            else if (!inside && proper == npos) {
+                proper = i;
+            }
+        }
+
+        if (ear == npos) {
+            ear = proper == npos ? 0 : proper;
+        }
+
+        added_.push_back({ring_[(ear + k - 1) % k], ring_[ear], ring_[(ear + 1) % k]});
+        ring_.erase(ring_.begin() + static_cast<std::ptrdiff_t>(ear));
+    }
+    added_.push_back({ring_[0], ring_[1], ring_[2]});
+
+    replace_triangles(cavity_, added_);
+    vertex_triangle_[v] = npos;
+}
+
+template <typename T>
+bool Delaunay<T>::shift_vertex(std::size_t v, const std::array<double, 2>& p) {
+    // If every triangle of the star stays CCW at the new position the mesh is
+    // still a valid triangulation; only star edges can have become
+    // non-Delaunay, and Lawson flips repair them. Otherwise nothing changes.
+    cavity_.clear();
+    const std::size_t first = vertex_triangle_[v];
+    std::size_t t = first;
+    do {
+        const auto& w = tri_vertices_[t];
+        const std::size_t i = w[0] == v ? 0 : (w[1] == v ? 1 : 2);
+        if (orient(w[(i + 1) % 3], w[(i + 2) % 3], p) <= 0) {
+            return false;
+        }
+        cavity_.push_back(t);
+        t = tri_neighbors_[t][(i + 1) % 3];
+    } while (t != first && t != npos);
+
+    if (t == npos) {
+        return false;
+    }
+
+    coords_[v] = p;
+    for (std::size_t s : cavity_) {
+        for (std::size_t u : tri_vertices_[s]) {
+            if (u >= SUPER_VERTICES) {
+                changed_.push_back(u - SUPER_VERTICES);
+            }
+        }
+    }
+    views_dirty_ = true;
+
+    added_slots_.assign(cavity_.begin(), cavity_.end());
+    restore_delaunay(added_slots_);
+
+    return true;
+}
+
+template <typename T>
+void Delaunay<T>::relabel_vertex(std::size_t from, std::size_t to) {
+    if (vertex_triangle_[from] != npos) {
+        rename_in_star(from, to);
+    }
+    else {
+        std::replace(duplicates_.begin(), duplicates_.end(), from, to);
+    }
+
+    points_[to - SUPER_VERTICES] = points_[from - SUPER_VERTICES];
+    coords_[to] = coords_[from];
+    vertex_triangle_[to] = vertex_triangle_[from];
+    views_dirty_ = true;
+}
+
+template <typename T>
+void Delaunay<T>::rename_in_star(std::size_t from, std::size_t to) {
+    // Triangles and constraints around from name to instead
+    const std::size_t first = vertex_triangle_[from];
+    std::size_t t = first;
+    do {
+        auto& w = tri_vertices_[t];
+        const std::size_t i = w[0] == from ? 0 : (w[1] == from ? 1 : 2);
+        const std::size_t r = w[(i + 1) % 3];
+        if (constraints_.erase(undirected_key(from, r))) {
+            constraints_.insert(undirected_key(to, r));
+        }
+        if (record_changes_ && r >= SUPER_VERTICES) {
+            changed_.push_back(r - SUPER_VERTICES);
+        }
+        w[i] = to;
+        t = tri_neighbors_[t][(i + 1) % 3];
+    } while (t != first && t != npos);
+}
+
+template <typename T>
+void Delaunay<T>::collect_duplicates() {
+    duplicates_.clear();
+    for (std::size_t v = SUPER_VERTICES; v < vertex_triangle_.size(); ++v) {
+        if (vertex_triangle_[v] == npos) {
+            duplicates_.push_back(v);
+        }
+    }
+}
+
+template <typename T>
+bool Delaunay<T>::promote_duplicate(std::size_t v) {
+    // A duplicate of v takes over its triangles and constraints, so the
+    // position stays in the mesh and v leaves it without any re-triangulation
+    for (std::size_t k = 0; k < duplicates_.size(); ++k) {
+        const std::size_t u = duplicates_[k];
+        if (std::abs(coords_[u][0] - coords_[v][0]) > TOLERANCE || std::abs(coords_[u][1] - coords_[v][1]) > TOLERANCE) {
+            continue;
+        }
+
+        rename_in_star(v, u);
+        vertex_triangle_[u] = vertex_triangle_[v];
+        vertex_triangle_[v] = npos;
+        duplicates_[k] = duplicates_.back();
+        duplicates_.pop_back();
+        changed_.push_back(u - SUPER_VERTICES);
+        changed_.push_back(v - SUPER_VERTICES);
+        views_dirty_ = true;
+
+        return true;
+    }
+
+    return false;
+}
+
+template <typename T>
+void Delaunay<T>::flip(std::size_t t, std::size_t k) {
+    // (a, b, c) and (d, c, b) sharing b-c become (a, b, d) and (a, d, c)
+    const std::size_t n = tri_neighbors_[t][k];
+    const std::size_t a = tri_vertices_[t][k];
+    const std::size_t b = tri_vertices_[t][(k + 1) % 3];
+    const std::size_t c = tri_vertices_[t][(k + 2) % 3];
+    const std::size_t j = edge_slot(n, c, b);
+    const std::size_t d = tri_vertices_[n][j];
+
+    const std::size_t t_ab = tri_neighbors_[t][(k + 2) % 3];
+    const std::size_t t_ca = tri_neighbors_[t][(k + 1) % 3];
+    const std::size_t n_bd = tri_neighbors_[n][(j + 1) % 3];
+    const std::size_t n_dc = tri_neighbors_[n][(j + 2) % 3];
+
+    tri_vertices_[t] = {a, b, d};
+    tri_neighbors_[t] = {n_bd, n, t_ab};
+    tri_vertices_[n] = {a, d, c};
+    tri_neighbors_[n] = {n_dc, t_ca, t};
+
+    if (n_bd != npos) {
+        tri_neighbors_[n_bd][edge_slot(n_bd, d, b)] = t;
+    }
+    if (t_ca != npos) {
+        tri_neighbors_[t_ca][edge_slot(t_ca, a, c)] = n;
+    }
+
+    vertex_triangle_[a] = t;
+    vertex_triangle_[b] = t;
+    vertex_triangle_[d] = t;
+    vertex_triangle_[c] = n;
+    if (record_changes_) {
+        for (std::size_t v : {a, b, c, d}) {
+            if (v >= SUPER_VERTICES) {
+                changed_.push_back(v - SUPER_VERTICES);
+            }
+        }
+    }
+    views_dirty_ = true;
+}
+
+template <typename T>
+void Delaunay<T>::restore_delaunay(std::vector<std::size_t>& pending) {
+    // Lawson flips; a flipped pair is re-checked, which spreads the repair
+    // exactly as far as the damage goes
+    while (!pending.empty()) {
+        const std::size_t t = pending.back();
+        pending.pop_back();
+        if (tri_vertices_[t][0] == npos) {
+            continue;
+        }
+
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[t][k];
+            if (n == npos) {
+                continue;
+            }
+
+            const auto& v = tri_vertices_[t];
+            const std::size_t b = v[(k + 1) % 3];
+            const std::size_t c = v[(k + 2) % 3];
+            if (!constraints_.empty() && constraints_.count(undirected_key(b, c))) {
+                continue;
+            }
+
+            const std::size_t d = tri_vertices_[n][edge_slot(n, c, b)];
+            if (in_circle(v[0], v[1], v[2], d) > 0) {
+                flip(t, k);
+                pending.push_back(t);
+                pending.push_back(n);
                 break;
             }
         }
+    }
+}
+
+template <typename T>
+bool Delaunay<T>::remove(const point_t& p) {
+    changed_.clear();
+    const std::size_t v = find_vertex({static_cast<double>(static_cast<T>(p[0])), static_cast<double>(static_cast<T>(p[1]))});
+    if (v == npos) {
+        return false;
+    }
+
+    // With a duplicate left at the position the mesh keeps its shape
+    if (!promote_duplicate(v)) {
+        detach_vertex(v);
+
+        // Near constraints the ears need not be constrained-Delaunay, and
+        // triangles beyond a dropped constraint may now see across it
+        if (!constraints_.empty() || !detached_constraints_.empty()) {
+            std::vector<std::size_t> pending = added_slots_;
+            restore_delaunay(pending);
+        }
 
-        if (!found) {
-            points_.push_back(p);
+        // A point that split a constraint: join the halves again
+        if (detached_constraints_.size() == 2 && orient(detached_constraints_[0], detached_constraints_[1], v) == 0) {
+            force_edge(detached_constraints_[0], detached_constraints_[1]);
         }
     }
 
-    // If we don't have a super-triangle yet, create one
-    if (!has_super_triangle_ && !points_.empty()) {
-        create_super_triangle();
+    // Keep points_ dense: the last point takes over the freed index
+    const std::size_t last = coords_.size() - 1;
+    if (v != last) {
+        relabel_vertex(last, v);
+        std::replace(changed_.begin(), changed_.end(), last - SUPER_VERTICES, v - SUPER_VERTICES);
+        changed_.push_back(v - SUPER_VERTICES);
     }
+    points_.pop_back();
+    coords_.pop_back();
+    vertex_triangle_.pop_back();
+    finish_update();
 
-    for (const auto& p : points) {
-        insert(p);
+    return true;
+}
+
+template <typename T>
+bool Delaunay<T>::move(const point_t& from, const point_t& to) {
+    const std::size_t v = find_vertex({static_cast<double>(static_cast<T>(from[0])), static_cast<double>(static_cast<T>(from[1]))});
+    if (v == npos) {
+        changed_.clear();
+        return false;
     }
+
+    return move(v - SUPER_VERTICES, to);
 }
 
 template <typename T>
-std::vector<std::size_t> Delaunay<T>::find_bad_triangles(const point_t& p) const {
-    std::vector<std::size_t> bad;
-    for (std::size_t i = 0; i < triangles_.size(); ++i) {
-        if (triangles_[i].circumcircle_contains(p)) {
-            bad.push_back(i);
+bool Delaunay<T>::move(std::size_t point, const point_t& to) {
+    changed_.clear();
+    const std::size_t v = point + SUPER_VERTICES;
+    if (v >= vertex_triangle_.size()) {
+        return false;
+    }
+
+    // Take v out of the mesh; a duplicate is already out, and one of v's
+    // duplicates keeps its position (and constraints) in
+    const std::array<double, 2> p = {static_cast<double>(static_cast<T>(to[0])), static_cast<double>(static_cast<T>(to[1]))};
+    std::vector<std::size_t> reattach;
+    if (vertex_triangle_[v] == npos) {
+        duplicates_.erase(std::find(duplicates_.begin(), duplicates_.end(), v));
+    }
+    else if (!promote_duplicate(v)) {
+        if (shift_vertex(v, p)) {
+            points_[point] = to;
+            finish_update();
+
+            return true;
+        }
+
+        detach_vertex(v);
+        reattach = detached_constraints_;
+        if (!constraints_.empty() || !reattach.empty()) {
+            std::vector<std::size_t> pending = added_slots_;
+            restore_delaunay(pending);
+        }
+    }
+
+    points_[point] = to;
+    coords_[v] = p;
+    changed_.push_back(point);
+
+    const std::size_t id = insert_vertex(v);
+    if (id == npos) {
+        // Left the super-triangle: grow it and start over
+        for (std::size_t r : reattach) {
+            constraints_.insert(undirected_key(v, r));
+        }
+        rebuild_mesh();
+    }
+    else if (id == v) {
+        for (std::size_t r : reattach) {
+            force_edge(v, r);
+        }
+    }
+    else {
+        // Landed on another point: merged into its vertex, constraints too
+        duplicates_.push_back(v);
+        for (std::size_t r : reattach) {
+            force_edge(id, r);
         }
     }
+    finish_update();
 
-    return bad;
+    return true;
 }
 
 template <typename T>
-std::vector<typename Delaunay<T>::edge_t> Delaunay<T>::find_polygon_hole(
-    const std::vector<std::size_t>& bad_indices) const {
+const std::vector<std::size_t>& Delaunay<T>::changed_points() const {
+    return changed_;
+}
 
-    std::vector<edge_t> polygon;
+/*
+================================================================================================================
+                                Constrained Edges
+================================================================================================================
+*/
+template <typename T>
+std::size_t Delaunay<T>::resolve_vertex(std::size_t v) const {
+    if (v >= vertex_triangle_.size()) {
+        return npos;
+    }
+    if (vertex_triangle_[v] != npos) {
+        return v;
+    }
 
-    // Collect all edges from bad triangles
-    std::vector<edge_t> all_edges;
-    for (std::size_t idx : bad_indices) {
-        const triangle_t& tri = triangles_[idx];
-        all_edges.emplace_back(tri.vertices[0], tri.vertices[1]);
-        all_edges.emplace_back(tri.vertices[1], tri.vertices[2]);
-        all_edges.emplace_back(tri.vertices[2], tri.vertices[0]);
+    // Duplicate input point: use the mesh vertex at the same position
+    const std::size_t t = locate_triangle(coords_[v]);
+    if (t == npos) {
+        return npos;
     }
+    for (std::size_t u : tri_vertices_[t]) {
+        if (std::abs(coords_[u][0] - coords_[v][0]) <= TOLERANCE && std::abs(coords_[u][1] - coords_[v][1]) <= TOLERANCE) {
+            return u;
+        }
+    }
+
+    return npos;
+}
+
+template <typename T>
+bool Delaunay<T>::has_edge(std::size_t a, std::size_t b) const {
+    const std::size_t first = vertex_triangle_[a];
+    std::size_t t = first;
+    do {
+        const auto& v = tri_vertices_[t];
+        const std::size_t i = v[0] == a ? 0 : (v[1] == a ? 1 : 2);
+        if (v[(i + 1) % 3] == b || v[(i + 2) % 3] == b) {
+            return true;
+        }
+        t = tri_neighbors_[t][(i + 1) % 3];
+    } while (t != first && t != npos);
+
+    return false;
+}
+
+template <typename T>
+void Delaunay<T>::force_edge(std::size_t a, std::size_t b) {
+    // Collinear vertices split the constraint into pieces handled one by one
+    std::vector<std::pair<std::size_t, std::size_t>> pending{{a, b}};
+    while (!pending.empty()) {
+        const auto [u, w] = pending.back();
+        pending.pop_back();
+        if (u == w) {
+            continue;
+        }
+        if (has_edge(u, w)) {
+            constraints_.insert(undirected_key(u, w));
+            continue;
+        }
+
+        const double dir_x = coords_[w][0] - coords_[u][0];
+        const double dir_y = coords_[w][1] - coords_[u][1];
+        auto ahead = [&](std::size_t c) {
+            return (coords_[c][0] - coords_[u][0]) * dir_x + (coords_[c][1] - coords_[u][1]) * dir_y > 0;
+        };
+
+        // Rotate around u to the triangle the segment leaves u through
+        std::size_t t = vertex_triangle_[u];
+        const std::size_t first = t;
+        std::size_t c = npos, d = npos, through = npos;
+        do {
+            const auto& v = tri_vertices_[t];
+            const std::size_t i = v[0] == u ? 0 : (v[1] == u ? 1 : 2);
+            const std::size_t cc = v[(i + 1) % 3];
+            const std::size_t dd = v[(i + 2) % 3];
+            const double oc = orient(u, w, cc);
+            const double od = orient(u, w, dd);
+
+            if (oc == 0 && ahead(cc)) {
+                through = cc;
+                break;
+            }
+            if (od == 0 && ahead(dd)) {
+                through = dd;
+                break;
+            }
+            if (oc < 0 && od > 0) {
+                c = cc;
+                d = dd;
+                break;
+            }
+            t = tri_neighbors_[t][(i + 1) % 3];
+        } while (t != first && t != npos);
+
+        if (through != npos) {
+            constraints_.insert(undirected_key(u, through));
+            pending.emplace_back(through, w);
+            continue;
+        }
+        if (c == npos) {
+            continue;  // Numerically degenerate fan around u
+        }
+
+        // Walk the crossed triangles, collecting the chains on both sides
+        cavity_.clear();
+        left_chain_.clear();
+        right_chain_.clear();
+        cavity_.push_back(t);
+        right_chain_.push_back(c);
+        left_chain_.push_back(d);
+
+        std::size_t end = w;
+        bool dropped = false;
+        while (true) {
+            // Crossing a constraint drops it: constraints are expected to
+            // meet only at shared endpoints
+            dropped |= constraints_.erase(undirected_key(c, d)) > 0;
+
+            const std::size_t n = tri_neighbors_[t][edge_slot(t, c, d)];
+            cavity_.push_back(n);
+            const std::size_t e = tri_vertices_[n][edge_slot(n, d, c)];
+            if (e == w) {
+                break;
+            }
 
-    // Find edges that appear only once (boundary edges)
-    for (std::size_t i = 0; i < all_edges.size(); ++i) {
-        bool is_shared = false;
-        for (std::size_t j = 0; j < all_edges.size(); ++j) {
-            if (i != j && all_edges[i] == all_edges[j]) {
-                is_shared = true;
+            const double oe = orient(u, w, e);
+            if (oe > 0) {
+                left_chain_.push_back(e);
+                d = e;
+            }
+            else if (oe < 0) {
+                right_chain_.push_back(e);
+                c = e;
+            }
+            else {
+                end = e;
+                pending.emplace_back(e, w);
                 break;
             }
+            t = n;
+        }
+
+        added_.clear();
+        fill_pseudo_polygon(u, end, left_chain_);
+        std::reverse(right_chain_.begin(), right_chain_.end());
+        fill_pseudo_polygon(end, u, right_chain_);
+
+        replace_triangles(cavity_, added_);
+        constraints_.insert(undirected_key(u, end));
+
+        // Triangles beyond a dropped constraint may now see across it
+        if (dropped) {
+            std::vector<std::size_t> repair = added_slots_;
+            restore_delaunay(repair);
+        }
+    }
+}
+
+template <typename T>
+void Delaunay<T>::fill_pseudo_polygon(std::size_t a, std::size_t b, const std::vector<std::size_t>& chain) {
+    // Chain runs from a to b on the left of a->b. The apex is the chain vertex
+    // whose circle through a and b is empty of the others; both sides recurse.
+    struct Range {
+        std::size_t a, b, first, last;
+    };
+
+    std::vector<Range> stack{{a, b, 0, chain.size()}};
+    while (!stack.empty()) {
+        const Range r = stack.back();
+        stack.pop_back();
+        if (r.first >= r.last) {
+            continue;
         }
 
-        if (!is_shared) {
-            polygon.push_back(all_edges[i]);
+        std::size_t apex = r.first;
+        for (std::size_t i = r.first + 1; i < r.last; ++i) {
+            if (in_circle(r.a, r.b, chain[apex], chain[i]) > 0) {
+                apex = i;
+            }
         }
+
+        added_.push_back({r.a, r.b, chain[apex]});
+        stack.push_back({r.a, chain[apex], r.first, apex});
+        stack.push_back({chain[apex], r.b, apex + 1, r.last});
+    }
+}
+
+template <typename T>
+void Delaunay<T>::insert_constraint(const point_t& a, const point_t& b) {
+    changed_.clear();
+    const std::size_t u = insert_point(a);
+    const std::size_t w = insert_point(b);
+    force_edge(resolve_vertex(u), resolve_vertex(w));
+    finish_update();
+}
+
+template <typename T>
+void Delaunay<T>::insert_constraint(std::size_t a, std::size_t b) {
+    changed_.clear();
+    const std::size_t u = resolve_vertex(a + SUPER_VERTICES);
+    const std::size_t w = resolve_vertex(b + SUPER_VERTICES);
+    if (u != npos && w != npos) {
+        force_edge(u, w);
     }
+    finish_update();
+}
 
-    return polygon;
+template <typename T>
+void Delaunay<T>::insert_constraints(const std::vector<Segment<T, 2>>& segments) {
+    changed_.clear();
+    for (const auto& s : segments) {
+        const std::size_t u = insert_point(s.p1_);
+        const std::size_t w = insert_point(s.p2_);
+        force_edge(resolve_vertex(u), resolve_vertex(w));
+    }
+    finish_update();
 }
 
 template <typename T>
-void Delaunay<T>::remove_triangles(std::vector<std::size_t>& indices) {
-    // Sort indices in descending order to remove from back to front
-    std::sort(indices.begin(), indices.end(), std::greater<std::size_t>());
-    for (std::size_t idx : indices) {
-        if (idx < triangles_.size()) {
-            triangles_.erase(triangles_.begin() + idx);
+bool Delaunay<T>::is_constrained(std::size_t a, std::size_t b) const {
+    return constraints_.count(undirected_key(a + SUPER_VERTICES, b + SUPER_VERTICES)) > 0;
+}
+
+template <typename T>
+std::vector<std::pair<std::size_t, std::size_t>> Delaunay<T>::constraints() const {
+    std::vector<std::pair<std::size_t, std::size_t>> result;
+    result.reserve(constraints_.size());
+    for (std::uint64_t key : constraints_) {
+        result.emplace_back(static_cast<std::size_t>(key >> 32) - SUPER_VERTICES,
+                            static_cast<std::size_t>(key & 0xFFFFFFFFULL) - SUPER_VERTICES);
+    }
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+/*
+================================================================================================================
+                                Accessors
+================================================================================================================
+*/
+template <typename T>
+void Delaunay<T>::refresh_views() const {
+    if (!views_dirty_) {
+        return;
+    }
+
+    triangles_.clear();
+    triangle_indices_.clear();
+    triangle_adjacency_.clear();
+    slot_to_public_.assign(tri_vertices_.size(), npos);
+
+    // Triangles touching the super-triangle are not part of the result
+    for (std::size_t t = 0; t < tri_vertices_.size(); ++t) {
+        const auto& v = tri_vertices_[t];
+        if (v[0] == npos || v[0] < SUPER_VERTICES || v[1] < SUPER_VERTICES || v[2] < SUPER_VERTICES) {
+            continue;
+        }
+
+        slot_to_public_[t] = triangles_.size();
+        triangle_indices_.push_back({v[0] - SUPER_VERTICES, v[1] - SUPER_VERTICES, v[2] - SUPER_VERTICES});
+        triangles_.emplace_back(points_[v[0] - SUPER_VERTICES], points_[v[1] - SUPER_VERTICES], points_[v[2] - SUPER_VERTICES]);
+    }
+
+    triangle_adjacency_.reserve(triangles_.size());
+    for (std::size_t t = 0; t < tri_vertices_.size(); ++t) {
+        if (slot_to_public_[t] == npos) {
+            continue;
         }
+
+        index_triple adjacent;
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = tri_neighbors_[t][k];
+            adjacent[k] = n == npos ? npos : slot_to_public_[n];
+        }
+        triangle_adjacency_.push_back(adjacent);
     }
+
+    views_dirty_ = false;
 }
 
 template <typename T>
 const std::vector<typename Delaunay<T>::triangle_t>& Delaunay<T>::triangles() const {
+    refresh_views();
     return triangles_;
 }
 
+template <typename T>
+const std::vector<typename Delaunay<T>::index_triple>& Delaunay<T>::triangle_indices() const {
+    refresh_views();
+    return triangle_indices_;
+}
+
+template <typename T>
+const std::vector<typename Delaunay<T>::index_triple>& Delaunay<T>::triangle_adjacency() const {
+    refresh_views();
+    return triangle_adjacency_;
+}
+
+template <typename T>
+void Delaunay<T>::export_mesh(std::array<std::array<double, 2>, 3>& corners,
+                              std::vector<index_triple>& triangles,
+                              std::vector<index_triple>& adjacency) const {
+    refresh_views();
+    const std::size_t n = points_.size();
+    auto external = [&](std::size_t v) { return v < SUPER_VERTICES ? n + v : v - SUPER_VERTICES; };
+
+    for (std::size_t k = 0; k < SUPER_VERTICES; ++k) {
+        corners[k] = coords_.empty() ? std::array<double, 2>{0, 0} : coords_[k];
+    }
+
+    // Public triangles keep their index, the rest are numbered after them
+    std::vector<std::size_t> order(tri_vertices_.size(), npos);
+    std::size_t next = triangles_.size();
+    for (std::size_t t = 0; t < tri_vertices_.size(); ++t) {
+        if (tri_vertices_[t][0] != npos) {
+            order[t] = slot_to_public_[t] != npos ? slot_to_public_[t] : next++;
+        }
+    }
+
+    triangles.assign(next, index_triple{});
+    adjacency.assign(next, index_triple{});
+    for (std::size_t t = 0; t < tri_vertices_.size(); ++t) {
+        if (order[t] == npos) {
+            continue;
+        }
+
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t nb = tri_neighbors_[t][k];
+            triangles[order[t]][k] = external(tri_vertices_[t][k]);
+            adjacency[order[t]][k] = nb == npos ? npos : order[nb];
+        }
+    }
+}
+
+template <typename T>
+void Delaunay<T>::import_mesh(const std::vector<point_t>& points,
+                              const std::array<std::array<double, 2>, 3>& corners,
+                              const std::vector<index_triple>& triangles,
+                              const std::vector<index_triple>& adjacency,
+                              const std::vector<std::pair<std::size_t, std::size_t>>& constraints) {
+    clear();
+    points_ = points;
+    const std::size_t n = points_.size();
+    auto internal = [&](std::size_t v) { return v >= n ? v - n : v + SUPER_VERTICES; };
+
+    coords_.resize(SUPER_VERTICES + n);
+    for (std::size_t k = 0; k < SUPER_VERTICES; ++k) {
+        coords_[k] = corners[k];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        coords_[SUPER_VERTICES + i] = {static_cast<double>(static_cast<T>(points_[i][0])),
+                                       static_cast<double>(static_cast<T>(points_[i][1]))};
+    }
+
+    vertex_triangle_.assign(SUPER_VERTICES + n, npos);
+    tri_vertices_.resize(triangles.size());
+    tri_neighbors_.resize(triangles.size());
+    mark_.assign(triangles.size(), 0);
+    for (std::size_t t = 0; t < triangles.size(); ++t) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            tri_vertices_[t][k] = internal(triangles[t][k]);
+            tri_neighbors_[t][k] = adjacency[t][k];
+            vertex_triangle_[tri_vertices_[t][k]] = t;
+        }
+    }
+
+    collect_duplicates();
+
+    for (const auto& c : constraints) {
+        constraints_.insert(undirected_key(c.first + SUPER_VERTICES, c.second + SUPER_VERTICES));
+    }
+
+    last_triangle_ = triangles.empty() ? npos : 0;
+    changed_.resize(n);
+    std::iota(changed_.begin(), changed_.end(), std::size_t{0});
+    views_dirty_ = true;
+}
+
 template <typename T>
 std::vector<typename Delaunay<T>::edge_t> Delaunay<T>::edges() const {
-    std::vector<edge_t> unique_edges;
-    for (const auto& tri : triangles_) {
-        for (int i = 0; i < 3; ++i) {
-            edge_t e(tri.vertices[i], tri.vertices[(i + 1) % 3]);
-
-            // Check if edge already exists
-            bool found = false;
-            for (const auto& existing : unique_edges) {
-                if (existing == e) {
-                    found = true;
-                    break;
-                }
-            }
+    refresh_views();
 
-            if (!found) {
-                unique_edges.push_back(e);
+    // Interior edges are reported by the lower-indexed of their two triangles
+    std::vector<edge_t> unique_edges;
+    for (std::size_t i = 0; i < triangle_indices_.size(); ++i) {
+        const auto& v = triangle_indices_[i];
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = triangle_adjacency_[i][k];
+            if (n == npos || i < n) {
+                unique_edges.emplace_back(points_[v[(k + 1) % 3]], points_[v[(k + 2) % 3]]);
             }
         }
     }
@@ -240,6 +1279,7 @@ const std::vector<typename Delaunay<T>::point_t>& Delaunay<T>::points() const {
 
 template <typename T>
 std::size_t Delaunay<T>::triangle_count() const {
+    refresh_views();
     return triangles_.size();
 }
 
@@ -250,28 +1290,54 @@ std::size_t Delaunay<T>::point_count() const {
 
 template <typename T>
 const typename Delaunay<T>::triangle_t* Delaunay<T>::locate(const point_t& p) const {
-    for (const auto& tri : triangles_) {
-        if (tri.contains(p)) {
-            return &tri;
-        }
+    refresh_views();
+    const std::size_t t = locate_triangle({static_cast<double>(static_cast<T>(p[0])),
+                                           static_cast<double>(static_cast<T>(p[1]))});
+    if (t == npos || slot_to_public_[t] == npos) {
+        return nullptr;
+    }
+
+    return &triangles_[slot_to_public_[t]];
+}
+
+template <typename T>
+std::vector<std::size_t> Delaunay<T>::vertex_neighbors(std::size_t point) const {
+    std::vector<std::size_t> ring;
+    vertex_neighbors(point, ring);
+
+    return ring;
+}
+
+template <typename T>
+void Delaunay<T>::vertex_neighbors(std::size_t point, std::vector<std::size_t>& ring) const {
+    ring.clear();
+    const std::size_t v = point + SUPER_VERTICES;
+    if (v >= vertex_triangle_.size() || vertex_triangle_[v] == npos) {
+        return;
     }
 
-    return nullptr;
+    const std::size_t first = vertex_triangle_[v];
+    std::size_t t = first;
+    do {
+        const auto& w = tri_vertices_[t];
+        const std::size_t i = w[0] == v ? 0 : (w[1] == v ? 1 : 2);
+        const std::size_t r = w[(i + 1) % 3];
+        ring.push_back(r < SUPER_VERTICES ? npos : r - SUPER_VERTICES);
+        t = tri_neighbors_[t][(i + 1) % 3];
+    } while (t != first && t != npos);
 }
 
 template <typename T>
 std::vector<std::size_t> Delaunay<T>::neighbors(std::size_t tri_idx) const {
+    refresh_views();
     std::vector<std::size_t> result;
-    if (tri_idx >= triangles_.size()) {
+    if (tri_idx >= triangle_adjacency_.size()) {
         return result;
     }
 
-    const triangle_t& target = triangles_[tri_idx];
-    for (std::size_t i = 0; i < triangles_.size(); ++i) {
-        if (i == tri_idx) continue;
-
-        if (target.shares_edge(triangles_[i])) {
-            result.push_back(i);
+    for (std::size_t n : triangle_adjacency_[tri_idx]) {
+        if (n != npos) {
+            result.push_back(n);
         }
     }
 
@@ -280,25 +1346,37 @@ std::vector<std::size_t> Delaunay<T>::neighbors(std::size_t tri_idx) const {
 
 template <typename T>
 bool Delaunay<T>::is_valid() const {
-    // Verify Delaunay property: no point lies inside any triangle's circumcircle
-    for (const auto& tri : triangles_) {
-        for (const auto& p : points_) {
-            // Skip vertices of the triangle
-            bool is_vertex = false;
-            for (int i = 0; i < 3; ++i) {
-                if (p == tri.vertices[i]) {
-                    is_vertex = true;
-                    break;
-                }
+    refresh_views();
+
+    // Locally Delaunay across every unconstrained edge implies the global
+    // empty-circumcircle property
+    for (std::size_t i = 0; i < triangles_.size(); ++i) {
+        const auto& tri = triangles_[i];
+        if (!tri.is_ccw()) {
+            return false;
+        }
+
+        auto center = tri.circumcenter();
+        auto r_sq = tri.circumradius_squared();
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t n = triangle_adjacency_[i][k];
+            if (n == npos) {
+                continue;
             }
 
-            if (is_vertex) continue;
+            // Adjacency must be symmetric
+            const auto& back = triangle_adjacency_[n];
+            const std::size_t j = back[0] == i ? 0 : (back[1] == i ? 1 : (back[2] == i ? 2 : npos));
+            if (j == npos) {
+                return false;
+            }
 
-            // Check if point is strictly inside circumcircle
-            auto center = tri.circumcenter();
-            auto r_sq = tri.circumradius_squared();
+            const auto& v = triangle_indices_[i];
+            if (is_constrained(v[(k + 1) % 3], v[(k + 2) % 3])) {
+                continue;
+            }
 
-            auto diff = p - center;
+            auto diff = points_[triangle_indices_[n][j]] - center;
             auto dist_sq = diff.dot(diff);
 
             // If point is strictly inside (not just on boundary), triangulation is invalid
@@ -313,49 +1391,8 @@ bool Delaunay<T>::is_valid() const {
 
 template <typename T>
 std::vector<typename Delaunay<T>::point_t> Delaunay<T>::convex_hull() const {
-    if (points_.size() < 3) {
-        return points_;
-    }
-
-    // Andrew's monotone chain algorithm
-    std::vector<point_t> sorted_points = points_;
-    std::sort(sorted_points.begin(), sorted_points.end(),
-        [](const point_t& a, const point_t& b) {
-            if (static_cast<T>(a[0]) != static_cast<T>(b[0])) {
-                return static_cast<T>(a[0]) < static_cast<T>(b[0]);
-            }
-    
-            return static_cast<T>(a[1]) < static_cast<T>(b[1]);
-        });
-
-    auto cross = [](const point_t& O, const point_t& A, const point_t& B) {
-        return (static_cast<T>(A[0]) - static_cast<T>(O[0])) * (static_cast<T>(B[1]) - static_cast<T>(O[1])) -
-               (static_cast<T>(A[1]) - static_cast<T>(O[1])) * (static_cast<T>(B[0]) - static_cast<T>(O[0]));
-    };
-
-    std::vector<point_t> hull;
-
-    // Build lower hull
-    for (const auto& p : sorted_points) {
-        while (hull.size() >= 2 && cross(hull[hull.size()-2], hull[hull.size()-1], p) <= 0) {
-            hull.pop_back();
-        }
-    
-        hull.push_back(p);
-    }
-
-    // Build upper hull
-    std::size_t lower_size = hull.size();
-    for (auto it = sorted_points.rbegin(); it != sorted_points.rend(); ++it) {
-        while (hull.size() > lower_size && cross(hull[hull.size()-2], hull[hull.size()-1], *it) <= 0) {
-            hull.pop_back();
-        }
-    
-        hull.push_back(*it);
-    }
-
-    hull.pop_back();  // Remove last point (same as first)
-    return hull;
+    // The hull depends only on the sites, not on the triangulation
+    return algo::convex_hull(points_);
 }
 
 template <typename T>
@@ -375,9 +1412,18 @@ std::vector<typename Delaunay<T>::edge_t> Delaunay<T>::hull_edges() const {
 
 template <typename T>
 void Delaunay<T>::clear() {
-    triangles_.clear();
     points_.clear();
-    has_super_triangle_ = false;
+    coords_.clear();
+    tri_vertices_.clear();
+    tri_neighbors_.clear();
+    free_triangles_.clear();
+    vertex_triangle_.clear();
+    duplicates_.clear();
+    constraints_.clear();
+    changed_.clear();
+    mark_.clear();
+    last_triangle_ = npos;
+    views_dirty_ = true;
 }
 
 #endif // DELAUNAY_TPP
@@ -0,0 +1,335 @@
+#ifndef FORTUNESWEEP_TPP
+#define FORTUNESWEEP_TPP
+
+#include "../include/FortuneSweep.hpp"
+#include <algorithm>
+#include <cmath>
+
+template <typename T>
+void FortuneSweep<T>::run(const std::vector<point_t>& sites) {
+    clear();
+    coords_.resize(sites.size());
+    order_.resize(sites.size());
+    for (std::size_t i = 0; i < sites.size(); ++i) {
+        coords_[i] = {static_cast<double>(static_cast<T>(sites[i][0])), static_cast<double>(static_cast<T>(sites[i][1]))};
+        order_[i] = i;
+    }
+
+    std::sort(order_.begin(), order_.end(), [this](std::size_t a, std::size_t b) {
+        // Among repeated sites the lowest index is kept, as in Delaunay
+        if (coords_[a][1] != coords_[b][1]) {
+            return coords_[a][1] < coords_[b][1];
+        }
+
+        return coords_[a][0] < coords_[b][0] || (coords_[a][0] == coords_[b][0] && a < b);
+    });
+
+    // Every site adds at most two arcs, one vertex and two edges (Euler)
+    arcs_.reserve(2 * sites.size());
+    vertices_.reserve(2 * sites.size());
+    edges_.reserve(3 * sites.size());
+
+    std::size_t next_site = 0;
+    while (next_site < order_.size() || !events_.empty()) {
+        if (!events_.empty() && (next_site == order_.size() || events_.top().y <= coords_[order_[next_site]][1])) {
+            const CircleEvent event = events_.top();
+            events_.pop();
+            if (arcs_[event.arc].event == event.id) {
+                sweep_ = event.y;
+                circle_event(event);
+            }
+            continue;
+        }
+
+        const std::size_t site = order_[next_site++];
+        if (next_site > 1 && coords_[site] == coords_[order_[next_site - 2]]) {
+            continue;  // Repeated site
+        }
+        sweep_ = coords_[site][1];
+        site_event(site);
+    }
+}
+
+template <typename T>
+const std::vector<typename FortuneSweep<T>::Vertex>& FortuneSweep<T>::vertices() const {
+    return vertices_;
+}
+
+template <typename T>
+const std::vector<typename FortuneSweep<T>::EdgeRecord>& FortuneSweep<T>::edges() const {
+    return edges_;
+}
+
+template <typename T>
+std::array<double, 2> FortuneSweep<T>::direction(const EdgeRecord& edge, std::size_t end) const {
+    const double dx = coords_[edge.right][0] - coords_[edge.left][0];
+    const double dy = coords_[edge.right][1] - coords_[edge.left][1];
+
+    return end == 1 ? std::array<double, 2>{-dy, dx} : std::array<double, 2>{dy, -dx};
+}
+
+template <typename T>
+void FortuneSweep<T>::clear() {
+    coords_.clear();
+    order_.clear();
+    arcs_.clear();
+    root_ = npos;
+    events_ = {};
+    next_event_ = 0;
+    sweep_ = 0.0;
+    vertices_.clear();
+    edges_.clear();
+}
+
+/*
+================================================================================================================
+                                Beach Line
+================================================================================================================
+*/
+template <typename T>
+double FortuneSweep<T>::breakpoint(std::size_t left_site, std::size_t right_site) const {
+    // Upper envelope of the parabolas y = (l + py) / 2 - (x - px)^2 / (2 (l - py));
+    // the breakpoint is the root of (yl - yr)(x) where it changes from + to -
+    const auto& a = coords_[left_site];
+    const auto& b = coords_[right_site];
+    const double da = 2 * (sweep_ - a[1]);
+    const double db = 2 * (sweep_ - b[1]);
+    if (da <= 0) {
+        return a[0];
+    }
+    if (db <= 0) {
+        return b[0];
+    }
+    if (a[1] == b[1]) {
+        return (a[0] + b[0]) / 2;
+    }
+
+    const double qa = 1 / db - 1 / da;
+    const double qb = 2 * a[0] / da - 2 * b[0] / db;
+    const double qc = b[0] * b[0] / db - a[0] * a[0] / da + (a[1] - b[1]) / 2;
+    const double root = std::sqrt(std::max(0.0, qb * qb - 4 * qa * qc));
+
+    // (-qb - root) / (2 qa), written to avoid cancellation
+    return qb < 0 ? 2 * qc / (root - qb) : (-qb - root) / (2 * qa);
+}
+
+template <typename T>
+std::size_t FortuneSweep<T>::find_arc(double x) const {
+    std::size_t node = root_;
+    while (true) {
+        const Arc& arc = arcs_[node];
+        if (arc.prev != npos && x < breakpoint(arcs_[arc.prev].site, arc.site) && arc.left != npos) {
+            node = arc.left;
+        }
+        else if (arc.next != npos && x > breakpoint(arc.site, arcs_[arc.next].site) && arc.right != npos) {
+            node = arc.right;
+        }
+        else {
+            return node;
+        }
+    }
+}
+
+template <typename T>
+std::size_t FortuneSweep<T>::new_arc(std::size_t site) {
+    // xorshift32 priorities keep the treap balanced in expectation
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+    arcs_.push_back(Arc{site, seed_});
+
+    return arcs_.size() - 1;
+}
+
+template <typename T>
+void FortuneSweep<T>::rotate_up(std::size_t x) {
+    const std::size_t p = arcs_[x].parent;
+    const std::size_t g = arcs_[p].parent;
+    if (arcs_[p].left == x) {
+        arcs_[p].left = arcs_[x].right;
+        if (arcs_[x].right != npos) {
+            arcs_[arcs_[x].right].parent = p;
+        }
+        arcs_[x].right = p;
+    }
+    else {
+        arcs_[p].right = arcs_[x].left;
+        if (arcs_[x].left != npos) {
+            arcs_[arcs_[x].left].parent = p;
+        }
+        arcs_[x].left = p;
+    }
+
+    arcs_[p].parent = x;
+    arcs_[x].parent = g;
+    if (g == npos) {
+        root_ = x;
+    }
+    else if (arcs_[g].left == p) {
+        arcs_[g].left = x;
+    }
+    else {
+        arcs_[g].right = x;
+    }
+}
+
+template <typename T>
+void FortuneSweep<T>::insert_after(std::size_t at, std::size_t x) {
+    const std::size_t next = arcs_[at].next;
+    arcs_[x].prev = at;
+    arcs_[x].next = next;
+    arcs_[at].next = x;
+    if (next != npos) {
+        arcs_[next].prev = x;
+    }
+
+    // In-order successor slot: right child of `at`, or left child of the
+    // old successor (the leftmost node of that subtree)
+    if (arcs_[at].right == npos) {
+        arcs_[at].right = x;
+        arcs_[x].parent = at;
+    }
+    else {
+        arcs_[next].left = x;
+        arcs_[x].parent = next;
+    }
+
+    while (arcs_[x].parent != npos && arcs_[arcs_[x].parent].priority < arcs_[x].priority) {
+        rotate_up(x);
+    }
+}
+
+template <typename T>
+void FortuneSweep<T>::erase(std::size_t x) {
+    // Rotate down to a leaf, then unlink
+    while (arcs_[x].left != npos || arcs_[x].right != npos) {
+        const std::size_t l = arcs_[x].left;
+        const std::size_t r = arcs_[x].right;
+        rotate_up(r == npos || (l != npos && arcs_[l].priority > arcs_[r].priority) ? l : r);
+    }
+
+    const std::size_t p = arcs_[x].parent;
+    if (p == npos) {
+        root_ = npos;
+    }
+    else if (arcs_[p].left == x) {
+        arcs_[p].left = npos;
+    }
+    else {
+        arcs_[p].right = npos;
+    }
+
+    const std::size_t prev = arcs_[x].prev;
+    const std::size_t next = arcs_[x].next;
+    if (prev != npos) {
+        arcs_[prev].next = next;
+    }
+    if (next != npos) {
+        arcs_[next].prev = prev;
+    }
+}
+
+/*
+================================================================================================================
+                                Events
+================================================================================================================
+*/
+template <typename T>
+std::size_t FortuneSweep<T>::new_edge(std::size_t left, std::size_t right, std::size_t start) {
+    edges_.push_back(EdgeRecord{left, right, {start, npos}});
+
+    return edges_.size() - 1;
+}
+
+template <typename T>
+void FortuneSweep<T>::site_event(std::size_t site) {
+    if (root_ == npos) {
+        root_ = new_arc(site);
+        return;
+    }
+
+    const std::size_t arc = find_arc(coords_[site][0]);
+    const std::size_t split = arcs_[arc].site;
+
+    // Sites on the first row: the arcs are still vertical rays, so the new
+    // one simply goes to the right (sites arrive in x order)
+    if (coords_[split][1] >= sweep_) {
+        const std::size_t added = new_arc(site);
+        insert_after(arc, added);
+        arcs_[arc].edge = new_edge(split, site, npos);
+        arcs_[arc].end = 1;
+        return;
+    }
+
+    // Split the arc: split | site | split, one new edge traced both ways
+    arcs_[arc].event = npos;
+    const std::size_t middle = new_arc(site);
+    const std::size_t right = new_arc(split);
+    arcs_[right].edge = arcs_[arc].edge;
+    arcs_[right].end = arcs_[arc].end;
+    insert_after(arc, middle);
+    insert_after(middle, right);
+
+    const std::size_t edge = new_edge(split, site, npos);
+    arcs_[arc].edge = edge;
+    arcs_[arc].end = 1;
+    arcs_[middle].edge = edge;
+    arcs_[middle].end = 0;
+
+    check_circle(arc);
+    check_circle(right);
+}
+
+template <typename T>
+void FortuneSweep<T>::circle_event(const CircleEvent& event) {
+    const std::size_t arc = event.arc;
+    const std::size_t prev = arcs_[arc].prev;
+    const std::size_t next = arcs_[arc].next;
+
+    // The middle arc vanishes: both of its breakpoints end at the vertex and
+    // the neighbours start a new edge from it
+    const std::size_t v = vertices_.size();
+    vertices_.push_back(Vertex{event.center, {arcs_[prev].site, arcs_[arc].site, arcs_[next].site}});
+    edges_[arcs_[prev].edge].ends[arcs_[prev].end] = v;
+    edges_[arcs_[arc].edge].ends[arcs_[arc].end] = v;
+
+    erase(arc);
+    arcs_[prev].event = npos;
+    arcs_[next].event = npos;
+    arcs_[prev].edge = new_edge(arcs_[prev].site, arcs_[next].site, v);
+    arcs_[prev].end = 1;
+
+    check_circle(prev);
+    check_circle(next);
+}
+
+template <typename T>
+void FortuneSweep<T>::check_circle(std::size_t arc) {
+    const std::size_t prev = arcs_[arc].prev;
+    const std::size_t next = arcs_[arc].next;
+    if (prev == npos || next == npos || arcs_[prev].site == arcs_[next].site) {
+        return;
+    }
+
+    // The breakpoints converge only when the three sites turn left
+    const auto& a = coords_[arcs_[prev].site];
+    const auto& b = coords_[arcs_[arc].site];
+    const auto& c = coords_[arcs_[next].site];
+    const double bx = b[0] - a[0], by = b[1] - a[1];
+    const double cx = c[0] - a[0], cy = c[1] - a[1];
+    const double d = 2 * (bx * cy - by * cx);
+    if (d <= 0) {
+        return;
+    }
+
+    const double b2 = bx * bx + by * by;
+    const double c2 = cx * cx + cy * cy;
+    const double ux = (cy * b2 - by * c2) / d;
+    const double uy = (bx * c2 - cx * b2) / d;
+    const std::array<double, 2> center = {a[0] + ux, a[1] + uy};
+
+    arcs_[arc].event = next_event_++;
+    events_.push(CircleEvent{center[1] + std::sqrt(ux * ux + uy * uy), center, arc, arcs_[arc].event});
+}
+
+#endif // FORTUNESWEEP_TPP
@@ -0,0 +1,461 @@
+#ifndef MESHIO_TPP
+#define MESHIO_TPP
+
+#include "../include/MeshIO.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MESHIO_HAS_MMAP 1
+#endif
+
+namespace algo {
+
+    static_assert(sizeof(DelaunayFileHeader) == 88, "DelaunayFileHeader must not contain padding");
+    static_assert(sizeof(VoronoiFileHeader) == 88, "VoronoiFileHeader must not contain padding");
+
+    namespace detail {
+
+        inline bool host_is_little_endian() {
+            const std::uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+
+            return first == 1;
+        }
+
+        inline std::uint64_t align8(std::uint64_t offset) {
+            return (offset + 7) & ~std::uint64_t{7};
+        }
+
+        // Sequential little-endian writer; sections are padded to 8 bytes
+        class LittleEndianWriter {
+        public:
+            explicit LittleEndianWriter(const std::string& path)
+                : out_(path, std::ios::binary | std::ios::trunc) {}
+
+            bool good() const { return static_cast<bool>(out_); }
+
+            template <typename U>
+            void write(const U* data, std::size_t count) {
+                if (host_is_little_endian()) {
+                    out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(U)));
+                }
+                else {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        unsigned char bytes[sizeof(U)];
+                        std::memcpy(bytes, &data[i], sizeof(U));
+                        std::reverse(bytes, bytes + sizeof(U));
+                        out_.write(reinterpret_cast<const char*>(bytes), sizeof(U));
+                    }
+                }
+                written_ += count * sizeof(U);
+            }
+
+            template <typename U>
+            void write(const U& value) {
+                write(&value, 1);
+            }
+
+            void pad() {
+                static const char zeros[8] = {};
+                const std::uint64_t target = align8(written_);
+                out_.write(zeros, static_cast<std::streamsize>(target - written_));
+                written_ = target;
+            }
+
+        private:
+            std::ofstream out_;
+            std::uint64_t written_ = 0;
+        };
+
+        inline bool section_fits(std::uint64_t offset, std::uint64_t bytes, std::size_t file_size) {
+            return offset % 8 == 0 && offset <= file_size && bytes <= file_size - offset;
+        }
+
+    } // namespace detail
+
+/*
+================================================================================================================
+                                MappedFile
+================================================================================================================
+*/
+    inline MappedFile::MappedFile(const std::string& path) {
+        open(path);
+    }
+
+    inline MappedFile::~MappedFile() {
+        close();
+    }
+
+    inline MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(other.data_), size_(other.size_), mapped_(other.mapped_), buffer_(std::move(other.buffer_)) {
+        if (!mapped_) {
+            data_ = buffer_.data();
+        }
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+
+    inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            buffer_ = std::move(other.buffer_);
+            if (!mapped_) {
+                data_ = buffer_.data();
+            }
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+        }
+
+        return *this;
+    }
+
+    inline bool MappedFile::open(const std::string& path) {
+        close();
+
+#ifdef MESHIO_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference
+        if (address == MAP_FAILED) {
+            return false;
+        }
+
+        data_ = static_cast<const unsigned char*>(address);
+        size_ = static_cast<std::size_t>(info.st_size);
+        mapped_ = true;
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            return false;
+        }
+
+        buffer_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        if (buffer_.empty() || !in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()))) {
+            buffer_.clear();
+            return false;
+        }
+
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+
+        return true;
+    }
+
+    inline void MappedFile::close() {
+#ifdef MESHIO_HAS_MMAP
+        if (mapped_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    inline bool MappedFile::is_open() const {
+        return data_ != nullptr;
+    }
+
+    inline const unsigned char* MappedFile::data() const {
+        return data_;
+    }
+
+    inline std::size_t MappedFile::size() const {
+        return size_;
+    }
+
+/*
+================================================================================================================
+                                Delaunay
+================================================================================================================
+*/
+    template <typename T>
+    bool save_delaunay(const Delaunay<T>& delaunay, const std::string& path) {
+        std::array<std::array<double, 2>, 3> corners;
+        std::vector<typename Delaunay<T>::index_triple> triangles;
+        std::vector<typename Delaunay<T>::index_triple> adjacency;
+        delaunay.export_mesh(corners, triangles, adjacency);
+
+        const auto& points = delaunay.points();
+        const auto constraints = delaunay.constraints();
+        if (points.size() + 3 >= NO_INDEX || triangles.size() >= NO_INDEX) {
+            return false;  // Does not fit 32-bit indices
+        }
+
+        DelaunayFileHeader header{};
+        std::memcpy(header.magic, "CGDT", 4);
+        header.version = MESH_FORMAT_VERSION;
+        header.point_count = points.size();
+        header.triangle_count = delaunay.triangle_count();
+        header.ghost_count = triangles.size() - header.triangle_count;
+        header.constraint_count = constraints.size();
+
+        header.points_offset = detail::align8(sizeof(DelaunayFileHeader));
+        header.corners_offset = header.points_offset + 16 * header.point_count;
+        header.triangles_offset = header.corners_offset + 48;
+        header.adjacency_offset = detail::align8(header.triangles_offset + 12 * triangles.size());
+        header.constraints_offset = detail::align8(header.adjacency_offset + 12 * triangles.size());
+        header.file_size = header.constraints_offset + 8 * header.constraint_count;
+
+        detail::LittleEndianWriter out(path);
+        if (!out.good()) {
+            return false;
+        }
+
+        out.write(header.magic, 4);
+        out.write(header.version);
+        out.write(&header.point_count, 10);  // The remaining uint64 fields, in order
+        out.pad();
+
+        std::vector<double> xy(2 * points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            xy[2 * i] = static_cast<double>(static_cast<T>(points[i][0]));
+            xy[2 * i + 1] = static_cast<double>(static_cast<T>(points[i][1]));
+        }
+        out.write(xy.data(), xy.size());
+        for (const auto& corner : corners) {
+            out.write(corner.data(), 2);
+        }
+
+        std::vector<std::uint32_t> indices(3 * triangles.size());
+        for (std::size_t t = 0; t < triangles.size(); ++t) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                indices[3 * t + k] = static_cast<std::uint32_t>(triangles[t][k]);
+            }
+        }
+        out.write(indices.data(), indices.size());
+        out.pad();
+
+        for (std::size_t t = 0; t < adjacency.size(); ++t) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::size_t nb = adjacency[t][k];
+                indices[3 * t + k] = nb == Delaunay<T>::npos ? NO_INDEX : static_cast<std::uint32_t>(nb);
+            }
+        }
+        out.write(indices.data(), indices.size());
+        out.pad();
+
+        for (const auto& c : constraints) {
+            const std::uint32_t ends[2] = {static_cast<std::uint32_t>(c.first), static_cast<std::uint32_t>(c.second)};
+            out.write(ends, 2);
+        }
+
+        return out.good();
+    }
+
+    inline bool view_delaunay(const MappedFile& file, DelaunayView& view) {
+        if (!file.is_open() || file.size() < sizeof(DelaunayFileHeader) || !detail::host_is_little_endian()) {
+            return false;
+        }
+
+        DelaunayFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, "CGDT", 4) != 0 || header.version != MESH_FORMAT_VERSION ||
+            header.file_size != file.size()) {
+            return false;
+        }
+
+        const std::uint64_t total = header.triangle_count + header.ghost_count;
+        if (!detail::section_fits(header.points_offset, 16 * header.point_count, file.size()) ||
+            !detail::section_fits(header.corners_offset, 48, file.size()) ||
+            !detail::section_fits(header.triangles_offset, 12 * total, file.size()) ||
+            !detail::section_fits(header.adjacency_offset, 12 * total, file.size()) ||
+            !detail::section_fits(header.constraints_offset, 8 * header.constraint_count, file.size())) {
+            return false;
+        }
+
+        const unsigned char* base = file.data();
+        view.point_count = static_cast<std::size_t>(header.point_count);
+        view.triangle_count = static_cast<std::size_t>(header.triangle_count);
+        view.ghost_count = static_cast<std::size_t>(header.ghost_count);
+        view.constraint_count = static_cast<std::size_t>(header.constraint_count);
+        view.points = reinterpret_cast<const double*>(base + header.points_offset);
+        view.corners = reinterpret_cast<const double*>(base + header.corners_offset);
+        view.triangles = reinterpret_cast<const std::uint32_t*>(base + header.triangles_offset);
+        view.adjacency = reinterpret_cast<const std::uint32_t*>(base + header.adjacency_offset);
+        view.constraints = reinterpret_cast<const std::uint32_t*>(base + header.constraints_offset);
+
+        return true;
+    }
+
+    template <typename T>
+    bool load_delaunay(const DelaunayView& view, Delaunay<T>& delaunay) {
+        using index_triple = typename Delaunay<T>::index_triple;
+        const std::size_t total = view.triangle_count + view.ghost_count;
+        const std::size_t vertex_count = view.point_count + 3;
+
+        std::vector<Point<T, 2>> points(view.point_count);
+        for (std::size_t i = 0; i < view.point_count; ++i) {
+            points[i] = Point<T, 2>{static_cast<T>(view.points[2 * i]), static_cast<T>(view.points[2 * i + 1])};
+        }
+
+        std::array<std::array<double, 2>, 3> corners;
+        for (std::size_t k = 0; k < 3; ++k) {
+            corners[k] = {view.corners[2 * k], view.corners[2 * k + 1]};
+        }
+
+        std::vector<index_triple> triangles(total);
+        std::vector<index_triple> adjacency(total);
+        for (std::size_t t = 0; t < total; ++t) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::uint32_t v = view.triangles[3 * t + k];
+                const std::uint32_t nb = view.adjacency[3 * t + k];
+                if (v >= vertex_count || (nb != NO_INDEX && nb >= total)) {
+                    return false;
+                }
+
+                triangles[t][k] = v;
+                adjacency[t][k] = nb == NO_INDEX ? Delaunay<T>::npos : nb;
+            }
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> constraints(view.constraint_count);
+        for (std::size_t c = 0; c < view.constraint_count; ++c) {
+            constraints[c] = {view.constraints[2 * c], view.constraints[2 * c + 1]};
+        }
+
+        delaunay.import_mesh(points, corners, triangles, adjacency, constraints);
+
+        return true;
+    }
+
+/*
+================================================================================================================
+                                Voronoi
+================================================================================================================
+*/
+    template <typename T>
+    bool save_voronoi(const Voronoi<T>& voronoi, const std::string& path) {
+        const auto& cells = voronoi.cells();
+
+        VoronoiFileHeader header{};
+        std::memcpy(header.magic, "CGVR", 4);
+        header.version = MESH_FORMAT_VERSION;
+        header.cell_count = cells.size();
+        for (const auto& cell : cells) {
+            header.vertex_count += cell.vertices.size();
+            header.neighbor_count += cell.neighbor_cells.size();
+        }
+
+        header.sites_offset = detail::align8(sizeof(VoronoiFileHeader));
+        header.vertex_offsets_offset = header.sites_offset + 16 * header.cell_count;
+        header.vertices_offset = header.vertex_offsets_offset + 8 * (header.cell_count + 1);
+        header.neighbor_offsets_offset = header.vertices_offset + 16 * header.vertex_count;
+        header.neighbors_offset = header.neighbor_offsets_offset + 8 * (header.cell_count + 1);
+        header.bounded_offset = detail::align8(header.neighbors_offset + 4 * header.neighbor_count);
+        header.file_size = header.bounded_offset + header.cell_count;
+
+        detail::LittleEndianWriter out(path);
+        if (!out.good()) {
+            return false;
+        }
+
+        out.write(header.magic, 4);
+        out.write(header.version);
+        out.write(&header.cell_count, 10);  // The remaining uint64 fields, in order
+        out.pad();
+
+        for (const auto& cell : cells) {
+            const double site[2] = {static_cast<double>(static_cast<T>(cell.site[0])),
+                                    static_cast<double>(static_cast<T>(cell.site[1]))};
+            out.write(site, 2);
+        }
+
+        std::uint64_t offset = 0;
+        out.write(offset);
+        for (const auto& cell : cells) {
+            offset += cell.vertices.size();
+            out.write(offset);
+        }
+
+        for (const auto& cell : cells) {
+            for (const auto& v : cell.vertices) {
+                const double xy[2] = {static_cast<double>(static_cast<T>(v[0])), static_cast<double>(static_cast<T>(v[1]))};
+                out.write(xy, 2);
+            }
+        }
+
+        offset = 0;
+        out.write(offset);
+        for (const auto& cell : cells) {
+            offset += cell.neighbor_cells.size();
+            out.write(offset);
+        }
+
+        for (const auto& cell : cells) {
+            for (std::size_t nb : cell.neighbor_cells) {
+                out.write(static_cast<std::uint32_t>(nb));
+            }
+        }
+        out.pad();
+
+        for (const auto& cell : cells) {
+            out.write(static_cast<std::uint8_t>(cell.is_bounded ? 1 : 0));
+        }
+
+        return out.good();
+    }
+
+    inline bool view_voronoi(const MappedFile& file, VoronoiView& view) {
+        if (!file.is_open() || file.size() < sizeof(VoronoiFileHeader) || !detail::host_is_little_endian()) {
+            return false;
+        }
+
+        VoronoiFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, "CGVR", 4) != 0 || header.version != MESH_FORMAT_VERSION ||
+            header.file_size != file.size()) {
+            return false;
+        }
+
+        if (!detail::section_fits(header.sites_offset, 16 * header.cell_count, file.size()) ||
+            !detail::section_fits(header.vertex_offsets_offset, 8 * (header.cell_count + 1), file.size()) ||
+            !detail::section_fits(header.vertices_offset, 16 * header.vertex_count, file.size()) ||
+            !detail::section_fits(header.neighbor_offsets_offset, 8 * (header.cell_count + 1), file.size()) ||
+            !detail::section_fits(header.neighbors_offset, 4 * header.neighbor_count, file.size()) ||
+            !detail::section_fits(header.bounded_offset, header.cell_count, file.size())) {
+            return false;
+        }
+
+        const unsigned char* base = file.data();
+        view.cell_count = static_cast<std::size_t>(header.cell_count);
+        view.vertex_count = static_cast<std::size_t>(header.vertex_count);
+        view.neighbor_count = static_cast<std::size_t>(header.neighbor_count);
+        view.sites = reinterpret_cast<const double*>(base + header.sites_offset);
+        view.vertex_offsets = reinterpret_cast<const std::uint64_t*>(base + header.vertex_offsets_offset);
+        view.vertices = reinterpret_cast<const double*>(base + header.vertices_offset);
+        view.neighbor_offsets = reinterpret_cast<const std::uint64_t*>(base + header.neighbor_offsets_offset);
+        view.neighbors = reinterpret_cast<const std::uint32_t*>(base + header.neighbors_offset);
+        view.bounded = reinterpret_cast<const std::uint8_t*>(base + header.bounded_offset);
+
+        return true;
+    }
+
+} // namespace algo
+
+#endif // MESHIO_TPP
@@ -0,0 +1,550 @@
+#ifndef POLYGONTRIANGULATOR_TPP
+#define POLYGONTRIANGULATOR_TPP
+
+#include "../include/PolygonTriangulator.hpp"
+#include <algorithm>
+#include <cmath>
+
+/*
+================================================================================================================
+                                Entry Points
+================================================================================================================
+*/
+template <typename T>
+const std::vector<typename PolygonTriangulator<T>::triangle_t>&
+PolygonTriangulator<T>::triangulate(const polygon_t& outer) {
+    if (outer.size() <= EAR_CLIPPING_LIMIT) {
+        return triangulate_ear_clipping(outer);
+    }
+
+    return triangulate_monotone(outer);
+}
+
+template <typename T>
+const std::vector<typename PolygonTriangulator<T>::triangle_t>&
+PolygonTriangulator<T>::triangulate(const polygon_t& outer, const std::vector<polygon_t>& holes) {
+    if (holes.empty()) {
+        return triangulate(outer);
+    }
+
+    return triangulate_monotone(outer, holes);
+}
+
+template <typename T>
+const std::vector<typename PolygonTriangulator<T>::triangle_t>&
+PolygonTriangulator<T>::triangulate_monotone(const polygon_t& outer, const std::vector<polygon_t>& holes) {
+    load(outer, holes);
+    if (xs_.size() < 3) {
+        return triangles_;
+    }
+
+    classify_vertices();
+    make_monotone();
+    build_faces();
+
+    return triangles_;
+}
+
+template <typename T>
+const std::vector<typename PolygonTriangulator<T>::triangle_t>&
+PolygonTriangulator<T>::triangulate_ear_clipping(const polygon_t& outer) {
+    load(outer, {});
+    if (xs_.size() >= 3) {
+        clip_ears();
+    }
+
+    return triangles_;
+}
+
+template <typename T>
+const std::vector<typename PolygonTriangulator<T>::triangle_t>& PolygonTriangulator<T>::triangles() const {
+    return triangles_;
+}
+
+/*
+================================================================================================================
+                                Input Rings
+================================================================================================================
+*/
+template <typename T>
+void PolygonTriangulator<T>::load(const polygon_t& outer, const std::vector<polygon_t>& holes) {
+    xs_.clear();
+    ys_.clear();
+    next_.clear();
+    prev_.clear();
+    triangles_.clear();
+
+    add_ring(outer, true);
+    for (const auto& hole : holes) {
+        add_ring(hole, false);
+    }
+
+    triangles_.reserve(xs_.size() + 2 * holes.size());
+}
+
+template <typename T>
+void PolygonTriangulator<T>::add_ring(const polygon_t& ring, bool counter_clockwise) {
+    const std::size_t base = xs_.size();
+    const std::size_t n = ring.size();
+    if (n < 3) {
+        return;
+    }
+
+    double area = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        xs_.push_back(static_cast<double>(static_cast<T>(ring[i][0])));
+        ys_.push_back(static_cast<double>(static_cast<T>(ring[i][1])));
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = (i + 1) % n;
+        area += xs_[base + i] * ys_[base + j] - xs_[base + j] * ys_[base + i];
+    }
+
+    // Outer ring runs CCW and holes CW, so the interior is always on the left
+    const bool forward = (area > 0) == counter_clockwise;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t succ = base + (i + 1) % n;
+        const std::size_t pred = base + (i + n - 1) % n;
+        next_.push_back(forward ? succ : pred);
+        prev_.push_back(forward ? pred : succ);
+    }
+}
+
+template <typename T>
+bool PolygonTriangulator<T>::above(std::size_t a, std::size_t b) const {
+    return ys_[a] > ys_[b] || (ys_[a] == ys_[b] && xs_[a] < xs_[b]);
+}
+
+template <typename T>
+double PolygonTriangulator<T>::orient(std::size_t a, std::size_t b, std::size_t c) const {
+    return (xs_[b] - xs_[a]) * (ys_[c] - ys_[a]) - (ys_[b] - ys_[a]) * (xs_[c] - xs_[a]);
+}
+
+template <typename T>
+void PolygonTriangulator<T>::emit(std::size_t a, std::size_t b, std::size_t c) {
+    if (orient(a, b, c) < 0) {
+        std::swap(b, c);
+    }
+
+    triangles_.push_back(triangle_t{a, b, c});
+}
+
+/*
+================================================================================================================
+                                Sweep Status
+================================================================================================================
+*/
+template <typename T>
+double PolygonTriangulator<T>::x_at(std::size_t edge, double y) const {
+    if (edge == npos) {
+        return probe_x_;
+    }
+
+    const std::size_t a = edge;
+    const std::size_t b = next_[edge];
+    if (ys_[a] == ys_[b]) {
+        // Horizontal edges behave as if the sweep line were tilted by an infinitesimal angle
+        return std::clamp(sweep_x_, std::min(xs_[a], xs_[b]), std::max(xs_[a], xs_[b]));
+    }
+
+    const double t = (y - ys_[a]) / (ys_[b] - ys_[a]);
+    return xs_[a] + t * (xs_[b] - xs_[a]);
+}
+
+template <typename T>
+bool PolygonTriangulator<T>::EdgeOrder::operator()(std::size_t a, std::size_t b) const {
+    if (a == b) {
+        return false;
+    }
+
+    const double xa = owner->x_at(a, owner->sweep_y_);
+    const double xb = owner->x_at(b, owner->sweep_y_);
+    if (xa != xb) {
+        return xa < xb;
+    }
+
+    if (a == npos || b == npos) {
+        return a == npos;  // The probe sorts before an edge through the same point
+    }
+
+    // Edges meeting on the sweep line: compare a little further down
+    const auto low = [this](std::size_t e) {
+        return std::min(owner->ys_[e], owner->ys_[owner->next_[e]]);
+    };
+    const double y = (owner->sweep_y_ + std::max(low(a), low(b))) / 2;
+    const double la = owner->x_at(a, y);
+    const double lb = owner->x_at(b, y);
+
+    return la != lb ? la < lb : a < b;
+}
+
+template <typename T>
+void PolygonTriangulator<T>::insert_edge(std::size_t edge, std::size_t helper) {
+    helper_[edge] = helper;
+    status_pos_[edge] = status_.insert(edge).first;
+}
+
+template <typename T>
+void PolygonTriangulator<T>::erase_edge(std::size_t edge) {
+    status_.erase(status_pos_[edge]);
+}
+
+template <typename T>
+std::size_t PolygonTriangulator<T>::left_edge_of(std::size_t v) {
+    probe_x_ = xs_[v];
+    auto it = status_.upper_bound(npos);
+    if (it == status_.begin()) {
+        return npos;
+    }
+
+    return *std::prev(it);
+}
+
+template <typename T>
+void PolygonTriangulator<T>::add_diagonal(std::size_t a, std::size_t b) {
+    if (a != b && b != npos) {
+        diagonals_.emplace_back(std::min(a, b), std::max(a, b));
+    }
+}
+
+/*
+================================================================================================================
+                                Monotone Decomposition
+================================================================================================================
+*/
+template <typename T>
+void PolygonTriangulator<T>::classify_vertices() {
+    const std::size_t n = xs_.size();
+    types_.resize(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        const std::size_t p = prev_[v];
+        const std::size_t q = next_[v];
+        const bool convex = orient(p, v, q) > 0;
+
+        if (above(v, p) && above(v, q)) {
+            types_[v] = convex ? VertexType::Start : VertexType::Split;
+        }
+        else if (above(p, v) && above(q, v)) {
+            types_[v] = convex ? VertexType::End : VertexType::Merge;
+        }
+        else {
+            types_[v] = VertexType::Regular;
+        }
+    }
+}
+
+template <typename T>
+void PolygonTriangulator<T>::make_monotone() {
+    const std::size_t n = xs_.size();
+
+    order_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order_[i] = i;
+    }
+
+    std::sort(order_.begin(), order_.end(), [this](std::size_t a, std::size_t b) {
+        return above(a, b);
+    });
+
+    helper_.assign(n, npos);
+    status_pos_.resize(n);
+    status_.clear();
+    diagonals_.clear();
+
+    auto is_merge = [this](std::size_t v) {
+        return v != npos && types_[v] == VertexType::Merge;
+    };
+
+    // Edge ids are their upper-ring start vertex: edge e runs from e to next_[e]
+    for (std::size_t v : order_) {
+        sweep_x_ = xs_[v];
+        sweep_y_ = ys_[v];
+        const std::size_t e_prev = prev_[v];
+
+        switch (types_[v]) {
+            case VertexType::Start:
+                insert_edge(v, v);
+                break;
+
+            case VertexType::End:
+                if (is_merge(helper_[e_prev])) {
+                    add_diagonal(v, helper_[e_prev]);
+                }
+                erase_edge(e_prev);
+                break;
+
+            case VertexType::Split: {
+                const std::size_t left = left_edge_of(v);
+                if (left != npos) {
+                    add_diagonal(v, helper_[left]);
+                    helper_[left] = v;
+                }
+                insert_edge(v, v);
+                break;
+            }
+
+            case VertexType::Merge: {
+                if (is_merge(helper_[e_prev])) {
+                    add_diagonal(v, helper_[e_prev]);
+                }
+                erase_edge(e_prev);
+
+                const std::size_t left = left_edge_of(v);
+                if (left != npos) {
+                    if (is_merge(helper_[left])) {
+                        add_diagonal(v, helper_[left]);
+                    }
+                    helper_[left] = v;
+                }
+                break;
+            }
+
+            case VertexType::Regular:
+                if (above(e_prev, v)) {
+                    // Left chain: the interior lies to the right of v
+                    if (is_merge(helper_[e_prev])) {
+                        add_diagonal(v, helper_[e_prev]);
+                    }
+                    erase_edge(e_prev);
+                    insert_edge(v, v);
+                }
+                else {
+                    const std::size_t left = left_edge_of(v);
+                    if (left != npos) {
+                        if (is_merge(helper_[left])) {
+                            add_diagonal(v, helper_[left]);
+                        }
+                        helper_[left] = v;
+                    }
+                }
+                break;
+        }
+    }
+
+    std::sort(diagonals_.begin(), diagonals_.end());
+    diagonals_.erase(std::unique(diagonals_.begin(), diagonals_.end()), diagonals_.end());
+}
+
+template <typename T>
+void PolygonTriangulator<T>::build_faces() {
+    const std::size_t n = xs_.size();
+
+    // Neighbour lists in CSR form: ring neighbours plus both ends of each diagonal
+    adj_start_.assign(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        adj_start_[v + 1] += 2;
+    }
+    for (const auto& [a, b] : diagonals_) {
+        ++adj_start_[a + 1];
+        ++adj_start_[b + 1];
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        adj_start_[v + 1] += adj_start_[v];
+    }
+
+    adj_.resize(adj_start_[n]);
+    adj_used_.assign(adj_start_[n], false);
+    std::vector<std::size_t>& fill = stack_;
+    fill.assign(adj_start_.begin(), adj_start_.end() - 1);
+    for (std::size_t v = 0; v < n; ++v) {
+        adj_[fill[v]++] = next_[v];
+        adj_[fill[v]++] = prev_[v];
+    }
+    for (const auto& [a, b] : diagonals_) {
+        adj_[fill[a]++] = b;
+        adj_[fill[b]++] = a;
+    }
+
+    for (std::size_t v = 0; v < n; ++v) {
+        auto first = adj_.begin() + adj_start_[v];
+        auto last = adj_.begin() + adj_start_[v + 1];
+        std::sort(first, last, [this, v](std::size_t a, std::size_t b) {
+            return std::atan2(ys_[a] - ys_[v], xs_[a] - xs_[v]) < std::atan2(ys_[b] - ys_[v], xs_[b] - xs_[v]);
+        });
+
+        // Half-edges towards prev_ run along the outside of the region
+        for (std::size_t k = adj_start_[v]; k < adj_start_[v + 1]; ++k) {
+            if (adj_[k] == prev_[v]) {
+                adj_used_[k] = true;
+            }
+        }
+    }
+
+    // Walk each face keeping it on the left: at every vertex take the
+    // neighbour that comes next clockwise after the one we arrived from
+    for (std::size_t v = 0; v < n; ++v) {
+        for (std::size_t k = adj_start_[v]; k < adj_start_[v + 1]; ++k) {
+            if (adj_used_[k]) {
+                continue;
+            }
+
+            face_.clear();
+            std::size_t cur = v;
+            std::size_t slot = k;
+            while (!adj_used_[slot]) {
+                adj_used_[slot] = true;
+                face_.push_back(cur);
+
+                const std::size_t nxt = adj_[slot];
+                const std::size_t first = adj_start_[nxt];
+                const std::size_t degree = adj_start_[nxt + 1] - first;
+                std::size_t pos = first;
+                while (adj_[pos] != cur) {
+                    ++pos;
+                }
+
+                slot = first + (pos - first + degree - 1) % degree;
+                cur = nxt;
+            }
+
+            triangulate_monotone_face();
+        }
+    }
+}
+
+template <typename T>
+void PolygonTriangulator<T>::triangulate_monotone_face() {
+    const std::size_t k = face_.size();
+    if (k < 3) {
+        return;
+    }
+
+    if (k == 3) {
+        emit(face_[0], face_[1], face_[2]);
+        return;
+    }
+
+    std::size_t top = 0;
+    std::size_t bottom = 0;
+    for (std::size_t i = 1; i < k; ++i) {
+        if (above(face_[i], face_[top])) top = i;
+        if (above(face_[bottom], face_[i])) bottom = i;
+    }
+
+    // Merge the two chains into one top-to-bottom order. Walking CCW from the
+    // top vertex runs down the left chain, walking CW runs down the right one.
+    sorted_face_.clear();
+    left_chain_.clear();
+    std::size_t l = top;
+    std::size_t r = (top + k - 1) % k;
+    sorted_face_.push_back(face_[top]);
+    left_chain_.push_back(true);
+    l = (l + 1) % k;
+    while (sorted_face_.size() < k) {
+        const bool left_done = l == (bottom + 1) % k;
+        const bool right_done = r == bottom;
+        if (!left_done && (right_done || above(face_[l], face_[r]))) {
+            sorted_face_.push_back(face_[l]);
+            left_chain_.push_back(true);
+            l = (l + 1) % k;
+        }
+        else {
+            sorted_face_.push_back(face_[r]);
+            left_chain_.push_back(false);
+            r = (r + k - 1) % k;
+        }
+    }
+
+    stack_.clear();
+    stack_.push_back(0);
+    stack_.push_back(1);
+    for (std::size_t j = 2; j + 1 < k; ++j) {
+        const std::size_t u = sorted_face_[j];
+        if (left_chain_[j] != left_chain_[stack_.back()]) {
+            // Opposite chain: fan to everything on the stack
+            while (stack_.size() > 1) {
+                const std::size_t a = stack_.back();
+                stack_.pop_back();
+                emit(u, sorted_face_[a], sorted_face_[stack_.back()]);
+            }
+
+            stack_.clear();
+            stack_.push_back(j - 1);
+            stack_.push_back(j);
+        }
+        else {
+            // Same chain: cut off triangles while the diagonal stays inside
+            std::size_t last = stack_.back();
+            stack_.pop_back();
+            while (!stack_.empty()) {
+                const double o = orient(u, sorted_face_[last], sorted_face_[stack_.back()]);
+                if (left_chain_[j] ? o >= 0 : o <= 0) {
+                    break;
+                }
+
+                emit(u, sorted_face_[last], sorted_face_[stack_.back()]);
+                last = stack_.back();
+                stack_.pop_back();
+            }
+
+            stack_.push_back(last);
+            stack_.push_back(j);
+        }
+    }
+
+    const std::size_t u = sorted_face_[k - 1];
+    while (stack_.size() > 1) {
+        const std::size_t a = stack_.back();
+        stack_.pop_back();
+        emit(u, sorted_face_[a], sorted_face_[stack_.back()]);
+    }
+}
+
+/*
+================================================================================================================
+                                Ear Clipping
+================================================================================================================
+*/
+template <typename T>
+bool PolygonTriangulator<T>::is_ear(std::size_t v) const {
+    const std::size_t p = prev_[v];
+    const std::size_t q = next_[v];
+    if (orient(p, v, q) <= 0) {
+        return false;  // Reflex or degenerate corner
+    }
+
+    for (std::size_t w = next_[q]; w != p; w = next_[w]) {
+        if (orient(p, v, w) >= 0 && orient(v, q, w) >= 0 && orient(q, p, w) >= 0) {
+            // Vertices coinciding with a corner do not block the ear
+            const bool duplicate = (xs_[w] == xs_[p] && ys_[w] == ys_[p]) ||
+                                   (xs_[w] == xs_[v] && ys_[w] == ys_[v]) ||
+                                   (xs_[w] == xs_[q] && ys_[w] == ys_[q]);
+            if (!duplicate) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+void PolygonTriangulator<T>::clip_ears() {
+    std::size_t remaining = xs_.size();
+    std::size_t v = 0;
+    std::size_t misses = 0;
+
+    while (remaining > 3) {
+        const std::size_t p = prev_[v];
+        const std::size_t q = next_[v];
+
+        // A full lap without an ear only happens on degenerate input: clip anyway
+        if (is_ear(v) || misses > remaining) {
+            emit(p, v, q);
+            next_[p] = q;
+            prev_[q] = p;
+            --remaining;
+            misses = 0;
+            v = q;
+        }
+        else {
+            ++misses;
+            v = q;
+        }
+    }
+
+    emit(prev_[v], v, next_[v]);
+}
+
+#endif // POLYGONTRIANGULATOR_TPP
@@ -0,0 +1,331 @@
+#ifndef PROXIMITY_TPP
+#define PROXIMITY_TPP
+
+#include "../include/Proximity.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace algo {
+
+    namespace detail {
+
+        // Below this many points a range is not worth a thread
+        constexpr std::size_t PROXIMITY_GRAIN = 1 << 14;
+
+        struct PairCandidate {
+            double distance2 = std::numeric_limits<double>::infinity();
+            std::size_t first = npos;
+            std::size_t second = npos;
+        };
+
+        struct ProximityPoint {
+            double x;
+            double y;
+            std::size_t index;
+        };
+
+        inline void keep_closer(PairCandidate& best, const ProximityPoint& a, const ProximityPoint& b) {
+            const double dx = a.x - b.x, dy = a.y - b.y;
+            const double d2 = dx * dx + dy * dy;
+            if (d2 < best.distance2) {
+                best = {d2, a.index, b.index};
+            }
+        }
+
+        // Chunks are sorted on worker threads, then merged pairwise
+        template <typename Compare>
+        void parallel_sort(std::vector<ProximityPoint>& data, Compare compare, std::size_t threads) {
+            const std::size_t n = data.size();
+            threads = std::max<std::size_t>(1, std::min(threads, n / PROXIMITY_GRAIN));
+            if (threads == 1) {
+                std::sort(data.begin(), data.end(), compare);
+                return;
+            }
+
+            std::vector<std::size_t> bounds(threads + 1);
+            for (std::size_t t = 0; t <= threads; ++t) {
+                bounds[t] = n * t / threads;
+            }
+
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&data, &bounds, &compare, t] {
+                    std::sort(data.begin() + bounds[t], data.begin() + bounds[t + 1], compare);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            for (std::size_t width = 1; width < threads; width *= 2) {
+                workers.clear();
+                for (std::size_t t = 0; t + width < threads; t += 2 * width) {
+                    const std::size_t first = bounds[t];
+                    const std::size_t middle = bounds[t + width];
+                    const std::size_t last = bounds[std::min(t + 2 * width, threads)];
+                    workers.emplace_back([&data, &compare, first, middle, last] {
+                        std::inplace_merge(data.begin() + first, data.begin() + middle, data.begin() + last, compare);
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+        }
+
+        // Closest pair of points[first, last) (sorted by x on entry, by y on
+        // exit). `buffer` is scratch of the same size as points; ranges are
+        // disjoint, so the halves can run on separate threads.
+        inline PairCandidate closest_pair_recursive(std::vector<ProximityPoint>& points,
+                                                    std::vector<ProximityPoint>& buffer,
+                                                    std::size_t first, std::size_t last,
+                                                    std::size_t threads) {
+            PairCandidate best;
+            if (last - first <= 3) {
+                for (std::size_t i = first; i < last; ++i) {
+                    for (std::size_t j = i + 1; j < last; ++j) {
+                        keep_closer(best, points[i], points[j]);
+                    }
+                }
+                std::sort(points.begin() + first, points.begin() + last,
+                    [](const ProximityPoint& a, const ProximityPoint& b) { return a.y < b.y; });
+                return best;
+            }
+
+            const std::size_t middle = first + (last - first) / 2;
+            const double split = points[middle].x;
+
+            PairCandidate left, right;
+            if (threads > 1 && last - first >= 2 * PROXIMITY_GRAIN) {
+                std::thread worker([&] {
+                    left = closest_pair_recursive(points, buffer, first, middle, threads / 2);
+                });
+                right = closest_pair_recursive(points, buffer, middle, last, threads - threads / 2);
+                worker.join();
+            }
+            else {
+                left = closest_pair_recursive(points, buffer, first, middle, 1);
+                right = closest_pair_recursive(points, buffer, middle, last, 1);
+            }
+            best = left.distance2 <= right.distance2 ? left : right;
+
+            std::merge(points.begin() + first, points.begin() + middle,
+                       points.begin() + middle, points.begin() + last, buffer.begin() + first,
+                       [](const ProximityPoint& a, const ProximityPoint& b) { return a.y < b.y; });
+            std::copy(buffer.begin() + first, buffer.begin() + last, points.begin() + first);
+
+            // Strip around the split line, in y order; each point only needs
+            // the few that follow it within the current distance
+            std::size_t strip_end = first;
+            for (std::size_t i = first; i < last; ++i) {
+                const double dx = points[i].x - split;
+                if (dx * dx < best.distance2) {
+                    buffer[strip_end++] = points[i];
+                }
+            }
+            for (std::size_t i = first; i < strip_end; ++i) {
+                for (std::size_t j = i + 1; j < strip_end; ++j) {
+                    const double dy = buffer[j].y - buffer[i].y;
+                    if (dy * dy >= best.distance2) {
+                        break;
+                    }
+                    keep_closer(best, buffer[i], buffer[j]);
+                }
+            }
+
+            return best;
+        }
+
+    } // namespace detail
+
+/*
+================================================================================================================
+                                Closest Pair
+================================================================================================================
+*/
+    template <typename T>
+    std::pair<std::size_t, std::size_t> closest_pair(const std::vector<Point<T, 2>>& points, std::size_t threads) {
+        if (points.size() < 2) {
+            return {npos, npos};
+        }
+
+        std::vector<detail::ProximityPoint> sorted(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            sorted[i] = {static_cast<double>(static_cast<T>(points[i][0])),
+                         static_cast<double>(static_cast<T>(points[i][1])), i};
+        }
+
+        threads = std::max<std::size_t>(1, threads);
+        detail::parallel_sort(sorted, [](const detail::ProximityPoint& a, const detail::ProximityPoint& b) {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        }, threads);
+
+        std::vector<detail::ProximityPoint> buffer(sorted.size());
+        const detail::PairCandidate best = detail::closest_pair_recursive(sorted, buffer, 0, sorted.size(), threads);
+
+        return {std::min(best.first, best.second), std::max(best.first, best.second)};
+    }
+
+/*
+================================================================================================================
+                                All Nearest Neighbors
+================================================================================================================
+*/
+    namespace detail {
+
+        // Nearest neighbour of every point among its fan, on worker threads.
+        // fan(i, ring) fills ring with the neighbours of i (npos entries are
+        // skipped); points with an empty fan are returned for the caller.
+        template <typename Fan>
+        std::vector<std::size_t> scan_fans(const std::vector<std::array<double, 2>>& coords, Fan fan,
+                                           std::vector<std::size_t>& nearest, std::size_t threads) {
+            const std::size_t n = coords.size();
+            threads = std::max<std::size_t>(1, std::min(threads, n / PROXIMITY_GRAIN));
+            std::vector<std::vector<std::size_t>> isolated(threads);
+            auto scan = [&](std::size_t t) {
+                std::vector<std::size_t> ring;
+                const std::size_t first = n * t / threads;
+                const std::size_t last = n * (t + 1) / threads;
+                for (std::size_t i = first; i < last; ++i) {
+                    fan(i, ring);
+                    double best = std::numeric_limits<double>::infinity();
+                    for (std::size_t j : ring) {
+                        if (j == npos) {
+                            continue;
+                        }
+
+                        const double dx = coords[j][0] - coords[i][0];
+                        const double dy = coords[j][1] - coords[i][1];
+                        const double d2 = dx * dx + dy * dy;
+                        if (d2 < best) {
+                            best = d2;
+                            nearest[i] = j;
+                        }
+                    }
+                    if (nearest[i] == npos) {
+                        isolated[t].push_back(i);
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t) {
+                workers.emplace_back(scan, t);
+            }
+            scan(0);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            std::vector<std::size_t> result;
+            for (const auto& chunk : isolated) {
+                result.insert(result.end(), chunk.begin(), chunk.end());
+            }
+
+            return result;
+        }
+
+        // A repeated point and the copy that stands for it are each other's
+        // nearest neighbours (distance 0 beats any fan neighbour)
+        inline void pair_repeated(std::vector<std::size_t>& nearest, std::size_t point, std::size_t kept) {
+            if (kept != npos && kept != point) {
+                nearest[point] = kept;
+                nearest[kept] = point;
+            }
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    std::vector<std::size_t> all_nearest_neighbors(const std::vector<Point<T, 2>>& points, std::size_t threads) {
+        const std::size_t n = points.size();
+        std::vector<std::size_t> nearest(n, npos);
+        if (n < 2) {
+            return nearest;
+        }
+
+        std::vector<std::array<double, 2>> coords(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            coords[i] = {static_cast<double>(static_cast<T>(points[i][0])), static_cast<double>(static_cast<T>(points[i][1]))};
+        }
+
+        // The Delaunay graph straight from Fortune's sweep (about twice as
+        // fast as triangulating): every Voronoi edge joins two neighbours.
+        // Adjacency goes into CSR form for the parallel scan.
+        FortuneSweep<T> sweep;
+        sweep.run(points);
+        std::vector<std::size_t> offsets(n + 1, 0);
+        for (const auto& edge : sweep.edges()) {
+            ++offsets[edge.left + 1];
+            ++offsets[edge.right + 1];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<std::size_t> adjacency(offsets[n]);
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : sweep.edges()) {
+            adjacency[fill[edge.left]++] = edge.right;
+            adjacency[fill[edge.right]++] = edge.left;
+        }
+
+        auto fan = [&](std::size_t i, std::vector<std::size_t>& ring) {
+            ring.assign(adjacency.begin() + offsets[i], adjacency.begin() + offsets[i + 1]);
+        };
+        const std::vector<std::size_t> isolated = detail::scan_fans(coords, fan, nearest, threads);
+        if (isolated.empty()) {
+            return nearest;
+        }
+
+        // The sweep skips repeated sites and keeps the lowest index of each
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&coords](std::size_t a, std::size_t b) {
+            return coords[a] < coords[b] || (coords[a] == coords[b] && a < b);
+        });
+        std::size_t kept = order[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            if (coords[order[i]] != coords[kept]) {
+                kept = order[i];
+            }
+            else {
+                detail::pair_repeated(nearest, order[i], kept);
+            }
+        }
+
+        return nearest;
+    }
+
+    template <typename T>
+    std::vector<std::size_t> all_nearest_neighbors(const Delaunay<T>& delaunay, std::size_t threads) {
+        const auto& points = delaunay.points();
+        const std::size_t n = points.size();
+        std::vector<std::size_t> nearest(n, npos);
+        if (n < 2) {
+            return nearest;
+        }
+
+        std::vector<std::array<double, 2>> coords(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            coords[i] = {static_cast<double>(static_cast<T>(points[i][0])), static_cast<double>(static_cast<T>(points[i][1]))};
+        }
+
+        auto fan = [&delaunay](std::size_t i, std::vector<std::size_t>& ring) {
+            delaunay.vertex_neighbors(i, ring);
+        };
+
+        // Repeated points have no fan of their own; find() gives the copy
+        // kept in the mesh
+        for (std::size_t i : detail::scan_fans(coords, fan, nearest, threads)) {
+            detail::pair_repeated(nearest, i, delaunay.find(points[i]));
+        }
+
+        return nearest;
+    }
+
+} // namespace algo
+
+#endif // PROXIMITY_TPP
@@ -0,0 +1,696 @@
+#ifndef RTREE_TPP
+#define RTREE_TPP
+
+#include "../include/RTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+template <typename T, std::size_t N>
+RTree<T, N>::RTree(std::vector<item_t> items) {
+    bulk_load(std::move(items));
+}
+
+/*
+================================================================================================================
+                                Node Pool
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+std::size_t RTree<T, N>::allocate_node(std::size_t level) {
+    std::size_t idx;
+    if (!free_nodes_.empty()) {
+        idx = free_nodes_.back();
+        free_nodes_.pop_back();
+    }
+    else {
+        idx = nodes_.size();
+        nodes_.emplace_back();
+    }
+
+    nodes_[idx].level = level;
+    nodes_[idx].count = 0;
+
+    return idx;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::release_node(std::size_t node_idx) {
+    nodes_[node_idx].count = 0;
+    free_nodes_.push_back(node_idx);
+}
+
+/*
+================================================================================================================
+                                Box Helpers
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+double RTree<T, N>::volume(const box_t& box) {
+    if (box.empty()) {
+        return 0.0;
+    }
+
+    double v = 1.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        v *= static_cast<double>(static_cast<T>(box.max()[i])) - static_cast<double>(static_cast<T>(box.min()[i]));
+    }
+
+    return v;
+}
+
+template <typename T, std::size_t N>
+double RTree<T, N>::margin(const box_t& box) {
+    if (box.empty()) {
+        return 0.0;
+    }
+
+    double m = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        m += static_cast<double>(static_cast<T>(box.max()[i])) - static_cast<double>(static_cast<T>(box.min()[i]));
+    }
+
+    return m;
+}
+
+template <typename T, std::size_t N>
+double RTree<T, N>::overlap(const box_t& a, const box_t& b) {
+    double v = 1.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        auto lo = std::max(static_cast<double>(static_cast<T>(a.min()[i])), static_cast<double>(static_cast<T>(b.min()[i])));
+        auto hi = std::min(static_cast<double>(static_cast<T>(a.max()[i])), static_cast<double>(static_cast<T>(b.max()[i])));
+        if (hi <= lo) {
+            return 0.0;
+        }
+
+        v *= hi - lo;
+    }
+
+    return v;
+}
+
+template <typename T, std::size_t N>
+typename RTree<T, N>::box_t RTree<T, N>::merged(const box_t& a, const box_t& b) {
+    box_t result = a;
+    result.expand(b);
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+double RTree<T, N>::enlargement(const box_t& box, const box_t& add) {
+    return volume(merged(box, add)) - volume(box);
+}
+
+template <typename T, std::size_t N>
+double RTree<T, N>::center(const box_t& box, std::size_t dim) {
+    return (static_cast<double>(static_cast<T>(box.min()[dim])) +
+            static_cast<double>(static_cast<T>(box.max()[dim]))) / 2;
+}
+
+template <typename T, std::size_t N>
+double RTree<T, N>::min_distance_squared(const box_t& box, const point_t& p) {
+    double d2 = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        auto v = static_cast<double>(static_cast<T>(p[i]));
+        auto lo = static_cast<double>(static_cast<T>(box.min()[i]));
+        auto hi = static_cast<double>(static_cast<T>(box.max()[i]));
+        double d = v < lo ? lo - v : (v > hi ? v - hi : 0.0);
+        d2 += d * d;
+    }
+
+    return d2;
+}
+
+template <typename T, std::size_t N>
+typename RTree<T, N>::box_t RTree<T, N>::node_bounds(std::size_t node_idx) const {
+    box_t box;
+    const Node& node = nodes_[node_idx];
+    for (std::size_t i = 0; i < node.count; ++i) {
+        box.expand(node.entries[i].box);
+    }
+
+    return box;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::refresh_entry(std::size_t parent_idx, std::size_t child_idx) {
+    Node& parent = nodes_[parent_idx];
+    for (std::size_t i = 0; i < parent.count; ++i) {
+        if (parent.entries[i].ref == child_idx) {
+            parent.entries[i].box = node_bounds(child_idx);
+            return;
+        }
+    }
+}
+
+/*
+================================================================================================================
+                                Insertion
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+void RTree<T, N>::insert(const box_t& box, std::size_t id) {
+    if (root_ == npos) {
+        root_ = allocate_node(0);
+    }
+
+    std::vector<bool> reinserted(nodes_[root_].level + 1, false);
+    insert_entry(Entry{box, id}, 0, reinserted);
+    ++size_;
+}
+
+template <typename T, std::size_t N>
+std::vector<std::size_t> RTree<T, N>::choose_path(const box_t& box, std::size_t level) const {
+    std::vector<std::size_t> path;
+    std::size_t node_idx = root_;
+    path.push_back(node_idx);
+
+    while (nodes_[node_idx].level > level) {
+        const Node& node = nodes_[node_idx];
+        std::size_t best = 0;
+        double best_primary = std::numeric_limits<double>::max();
+        double best_enlarge = std::numeric_limits<double>::max();
+        double best_volume = std::numeric_limits<double>::max();
+
+        for (std::size_t i = 0; i < node.count; ++i) {
+            const box_t& child = node.entries[i].box;
+            const double enlarge = enlargement(child, box);
+            const double vol = volume(child);
+
+            // Above leaves: least overlap enlargement; elsewhere: least volume enlargement
+            double primary = enlarge;
+            if (node.level == 1) {
+                const box_t grown = merged(child, box);
+                primary = 0.0;
+                for (std::size_t j = 0; j < node.count; ++j) {
+                    if (j != i) {
+                        primary += overlap(grown, node.entries[j].box) - overlap(child, node.entries[j].box);
+                    }
+                }
+            }
+
+            if (primary < best_primary ||
+                (primary == best_primary && (enlarge < best_enlarge ||
+                                            (enlarge == best_enlarge && vol < best_volume)))) {
+                best = i;
+                best_primary = primary;
+                best_enlarge = enlarge;
+                best_volume = vol;
+            }
+        }
+
+        node_idx = node.entries[best].ref;
+        path.push_back(node_idx);
+    }
+
+    return path;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::insert_entry(const Entry& entry, std::size_t level, std::vector<bool>& reinserted) {
+    auto path = choose_path(entry.box, level);
+    {
+        Node& target = nodes_[path.back()];
+        target.entries[target.count++] = entry;
+    }
+
+    for (std::size_t i = path.size(); i-- > 0;) {
+        const std::size_t node_idx = path[i];
+        if (nodes_[node_idx].count <= MAX_ENTRIES) {
+            if (i > 0) {
+                refresh_entry(path[i - 1], node_idx);
+            }
+
+            continue;
+        }
+
+        // Overflow: forced reinsertion once per level, then split
+        const std::size_t node_level = nodes_[node_idx].level;
+        if (node_level >= reinserted.size()) {
+            reinserted.resize(node_level + 1, false);
+        }
+
+        if (i > 0 && !reinserted[node_level]) {
+            reinserted[node_level] = true;
+            auto removed = take_reinsert_entries(node_idx);
+            for (std::size_t j = i; j > 0; --j) {
+                refresh_entry(path[j - 1], path[j]);
+            }
+
+            for (const auto& e : removed) {
+                insert_entry(e, node_level, reinserted);
+            }
+
+            return;
+        }
+
+        const std::size_t sibling = split(node_idx);
+        if (i == 0) {
+            grow_root(node_idx, sibling);
+            return;
+        }
+
+        refresh_entry(path[i - 1], node_idx);
+        Node& parent = nodes_[path[i - 1]];
+        parent.entries[parent.count++] = Entry{node_bounds(sibling), sibling};
+    }
+}
+
+template <typename T, std::size_t N>
+std::vector<typename RTree<T, N>::Entry> RTree<T, N>::take_reinsert_entries(std::size_t node_idx) {
+    const box_t bounds = node_bounds(node_idx);
+    Node& node = nodes_[node_idx];
+
+    auto distance = [&bounds](const Entry& e) {
+        double d2 = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            double d = center(e.box, i) - center(bounds, i);
+            d2 += d * d;
+        }
+
+        return d2;
+    };
+
+    // Farthest entries from the node center go first
+    std::sort(node.entries.begin(), node.entries.begin() + node.count,
+        [&distance](const Entry& a, const Entry& b) {
+            return distance(a) > distance(b);
+        });
+
+    // Close reinsert: the nearest of the removed entries is reinserted first
+    std::vector<Entry> removed(node.entries.begin(), node.entries.begin() + REINSERT_COUNT);
+    std::reverse(removed.begin(), removed.end());
+
+    std::move(node.entries.begin() + REINSERT_COUNT, node.entries.begin() + node.count, node.entries.begin());
+    node.count -= REINSERT_COUNT;
+
+    return removed;
+}
+
+template <typename T, std::size_t N>
+std::size_t RTree<T, N>::split(std::size_t node_idx) {
+    std::vector<Entry> items(nodes_[node_idx].entries.begin(),
+                             nodes_[node_idx].entries.begin() + nodes_[node_idx].count);
+    const std::size_t total = items.size();
+
+    std::vector<box_t> prefix(total);
+    std::vector<box_t> suffix(total);
+    auto sort_items = [&items](std::size_t axis, bool by_max) {
+        std::sort(items.begin(), items.end(), [axis, by_max](const Entry& a, const Entry& b) {
+            const auto& pa = by_max ? a.box.max() : a.box.min();
+            const auto& pb = by_max ? b.box.max() : b.box.min();
+            return static_cast<T>(pa[axis]) < static_cast<T>(pb[axis]);
+        });
+    };
+    auto accumulate = [&]() {
+        prefix[0] = items[0].box;
+        for (std::size_t i = 1; i < total; ++i) {
+            prefix[i] = merged(prefix[i - 1], items[i].box);
+        }
+
+        suffix[total - 1] = items[total - 1].box;
+        for (std::size_t i = total - 1; i-- > 0;) {
+            suffix[i] = merged(suffix[i + 1], items[i].box);
+        }
+    };
+
+    // ChooseSplitAxis: smallest sum of margins over all distributions
+    std::size_t best_axis = 0;
+    double best_margin = std::numeric_limits<double>::max();
+    for (std::size_t axis = 0; axis < N; ++axis) {
+        double margin_sum = 0.0;
+        for (bool by_max : {false, true}) {
+            sort_items(axis, by_max);
+            accumulate();
+            for (std::size_t k = MIN_ENTRIES; k <= total - MIN_ENTRIES; ++k) {
+                margin_sum += margin(prefix[k - 1]) + margin(suffix[k]);
+            }
+        }
+
+        if (margin_sum < best_margin) {
+            best_margin = margin_sum;
+            best_axis = axis;
+        }
+    }
+
+    // ChooseSplitIndex: least overlap, then least total volume
+    bool best_by_max = false;
+    std::size_t best_k = MIN_ENTRIES;
+    double best_overlap = std::numeric_limits<double>::max();
+    double best_volume = std::numeric_limits<double>::max();
+    for (bool by_max : {false, true}) {
+        sort_items(best_axis, by_max);
+        accumulate();
+        for (std::size_t k = MIN_ENTRIES; k <= total - MIN_ENTRIES; ++k) {
+            const double ov = overlap(prefix[k - 1], suffix[k]);
+            const double vol = volume(prefix[k - 1]) + volume(suffix[k]);
+            if (ov < best_overlap || (ov == best_overlap && vol < best_volume)) {
+                best_overlap = ov;
+                best_volume = vol;
+                best_by_max = by_max;
+                best_k = k;
+            }
+        }
+    }
+
+    sort_items(best_axis, best_by_max);
+
+    const std::size_t sibling = allocate_node(nodes_[node_idx].level);
+    Node& node = nodes_[node_idx];
+    Node& other = nodes_[sibling];
+
+    node.count = 0;
+    for (std::size_t i = 0; i < best_k; ++i) {
+        node.entries[node.count++] = items[i];
+    }
+
+    for (std::size_t i = best_k; i < total; ++i) {
+        other.entries[other.count++] = items[i];
+    }
+
+    return sibling;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::grow_root(std::size_t left, std::size_t right) {
+    const std::size_t new_root = allocate_node(nodes_[left].level + 1);
+    Node& root = nodes_[new_root];
+    root.entries[root.count++] = Entry{node_bounds(left), left};
+    root.entries[root.count++] = Entry{node_bounds(right), right};
+    root_ = new_root;
+}
+
+/*
+================================================================================================================
+                                Removal
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+bool RTree<T, N>::find_leaf(std::size_t node_idx, const box_t& box, std::size_t id,
+                            std::vector<std::size_t>& path) const {
+    const Node& node = nodes_[node_idx];
+    path.push_back(node_idx);
+
+    if (node.level == 0) {
+        for (std::size_t i = 0; i < node.count; ++i) {
+            if (node.entries[i].ref == id) {
+                return true;
+            }
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < node.count; ++i) {
+            if (node.entries[i].box.intersects(box) &&
+                find_leaf(node.entries[i].ref, box, id, path)) {
+                return true;
+            }
+        }
+    }
+
+    path.pop_back();
+    return false;
+}
+
+template <typename T, std::size_t N>
+bool RTree<T, N>::remove(const box_t& box, std::size_t id) {
+    if (root_ == npos) {
+        return false;
+    }
+
+    std::vector<std::size_t> path;
+    if (!find_leaf(root_, box, id, path)) {
+        return false;
+    }
+
+    {
+        Node& leaf = nodes_[path.back()];
+        for (std::size_t i = 0; i < leaf.count; ++i) {
+            if (leaf.entries[i].ref == id) {
+                leaf.entries[i] = leaf.entries[--leaf.count];
+                break;
+            }
+        }
+    }
+
+    // CondenseTree: dissolve underfull nodes and keep their entries for reinsertion
+    std::vector<std::pair<Entry, std::size_t>> orphans;
+    for (std::size_t i = path.size() - 1; i > 0; --i) {
+        const std::size_t node_idx = path[i];
+        Node& parent = nodes_[path[i - 1]];
+
+        if (nodes_[node_idx].count < MIN_ENTRIES) {
+            for (std::size_t j = 0; j < parent.count; ++j) {
+                if (parent.entries[j].ref == node_idx) {
+                    parent.entries[j] = parent.entries[--parent.count];
+                    break;
+                }
+            }
+
+            const Node& node = nodes_[node_idx];
+            for (std::size_t j = 0; j < node.count; ++j) {
+                orphans.emplace_back(node.entries[j], node.level);
+            }
+
+            release_node(node_idx);
+        }
+        else {
+            refresh_entry(path[i - 1], node_idx);
+        }
+    }
+
+    // Every child of the root was dissolved: restart from an empty leaf root
+    if (nodes_[root_].count == 0) {
+        nodes_[root_].level = 0;
+    }
+
+    // Higher subtrees first so that they land at their original height
+    std::sort(orphans.begin(), orphans.end(), [](const auto& a, const auto& b) {
+        return a.second < b.second;
+    });
+
+    while (!orphans.empty()) {
+        auto [entry, level] = orphans.back();
+        orphans.pop_back();
+
+        // The tree became too short for this subtree: reinsert its children instead
+        if (level > nodes_[root_].level) {
+            const Node& child = nodes_[entry.ref];
+            for (std::size_t j = 0; j < child.count; ++j) {
+                orphans.emplace_back(child.entries[j], child.level);
+            }
+
+            release_node(entry.ref);
+            continue;
+        }
+
+        std::vector<bool> reinserted(nodes_[root_].level + 1, false);
+        insert_entry(entry, level, reinserted);
+    }
+
+    // Shorten the tree while the root is an internal node with a single child
+    while (nodes_[root_].level > 0 && nodes_[root_].count == 1) {
+        const std::size_t child = nodes_[root_].entries[0].ref;
+        release_node(root_);
+        root_ = child;
+    }
+
+    --size_;
+    if (size_ == 0) {
+        clear();
+    }
+
+    return true;
+}
+
+/*
+================================================================================================================
+                                STR Bulk Loading
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+void RTree<T, N>::bulk_load(std::vector<item_t> items) {
+    clear();
+    if (items.empty()) {
+        return;
+    }
+
+    std::vector<Entry> level_entries;
+    level_entries.reserve(items.size());
+    for (auto& [box, id] : items) {
+        level_entries.push_back(Entry{std::move(box), id});
+    }
+
+    size_ = level_entries.size();
+    nodes_.reserve(2 * (size_ / (MAX_ENTRIES - 1) + 1));
+
+    // Pack one level at a time until a single node remains
+    std::size_t level = 0;
+    do {
+        level_entries = str_pack(level_entries, level);
+        ++level;
+    } while (level_entries.size() > 1);
+
+    root_ = level_entries[0].ref;
+}
+
+template <typename T, std::size_t N>
+std::vector<typename RTree<T, N>::Entry> RTree<T, N>::str_pack(std::vector<Entry>& entries, std::size_t level) {
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    str_tile(entries.begin(), entries.end(), 0, groups, 0);
+
+    std::vector<Entry> parents;
+    parents.reserve(groups.size());
+    for (const auto& [first, last] : groups) {
+        const std::size_t node_idx = allocate_node(level);
+        Node& node = nodes_[node_idx];
+        for (std::size_t i = first; i < last; ++i) {
+            node.entries[node.count++] = entries[i];
+        }
+
+        parents.push_back(Entry{node_bounds(node_idx), node_idx});
+    }
+
+    return parents;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::str_tile(typename std::vector<Entry>::iterator begin, typename std::vector<Entry>::iterator end,
+                           std::size_t dim, std::vector<std::pair<std::size_t, std::size_t>>& groups,
+                           std::size_t offset) {
+    const std::size_t count = static_cast<std::size_t>(end - begin);
+    const std::size_t node_count = (count + MAX_ENTRIES - 1) / MAX_ENTRIES;
+
+    std::sort(begin, end, [dim](const Entry& a, const Entry& b) {
+        return center(a.box, dim) < center(b.box, dim);
+    });
+
+    if (dim + 1 == N || node_count <= 1) {
+        // Last axis: cut into node_count runs of near-equal size
+        for (std::size_t g = 0; g < node_count; ++g) {
+            groups.emplace_back(offset + count * g / node_count, offset + count * (g + 1) / node_count);
+        }
+
+        return;
+    }
+
+    // Slice into S slabs along this axis, S = ceil(P^(1/(remaining dims)))
+    const auto slabs = static_cast<std::size_t>(
+        std::ceil(std::pow(static_cast<double>(node_count), 1.0 / static_cast<double>(N - dim))));
+    const std::size_t slab_size = MAX_ENTRIES * ((node_count + slabs - 1) / slabs);
+    for (std::size_t first = 0; first < count; first += slab_size) {
+        const std::size_t last = std::min(count, first + slab_size);
+        str_tile(begin + first, begin + last, dim + 1, groups, offset + first);
+    }
+}
+
+/*
+================================================================================================================
+                                Queries
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+std::vector<std::size_t> RTree<T, N>::query(const box_t& box) const {
+    std::vector<std::size_t> result;
+    query(box, result);
+
+    return result;
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::query(const box_t& box, std::vector<std::size_t>& out) const {
+    if (root_ == npos || box.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> stack;
+    stack.reserve(32);
+    stack.push_back(root_);
+    while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        for (std::size_t i = 0; i < node.count; ++i) {
+            if (!node.entries[i].box.intersects(box)) {
+                continue;
+            }
+
+            if (node.level == 0) {
+                out.push_back(node.entries[i].ref);
+            }
+            else {
+                stack.push_back(node.entries[i].ref);
+            }
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+std::vector<std::size_t> RTree<T, N>::nearest(const point_t& p, std::size_t k) const {
+    std::vector<std::size_t> result;
+    if (root_ == npos || k == 0) {
+        return result;
+    }
+
+    // Best-first search: a popped item is closer than anything still queued
+    struct Candidate {
+        double dist_sq;
+        std::size_t ref;
+        bool is_item;
+        bool operator>(const Candidate& other) const { return dist_sq > other.dist_sq; }
+    };
+
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+    queue.push({0.0, root_, false});
+    while (!queue.empty() && result.size() < k) {
+        Candidate top = queue.top();
+        queue.pop();
+
+        if (top.is_item) {
+            result.push_back(top.ref);
+            continue;
+        }
+
+        const Node& node = nodes_[top.ref];
+        for (std::size_t i = 0; i < node.count; ++i) {
+            queue.push({min_distance_squared(node.entries[i].box, p), node.entries[i].ref, node.level == 0});
+        }
+    }
+
+    return result;
+}
+
+/*
+================================================================================================================
+                                Accessors
+================================================================================================================
+*/
+template <typename T, std::size_t N>
+std::size_t RTree<T, N>::size() const {
+    return size_;
+}
+
+template <typename T, std::size_t N>
+bool RTree<T, N>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, std::size_t N>
+std::size_t RTree<T, N>::height() const {
+    return root_ == npos ? 0 : nodes_[root_].level + 1;
+}
+
+template <typename T, std::size_t N>
+typename RTree<T, N>::box_t RTree<T, N>::bounds() const {
+    return root_ == npos ? box_t() : node_bounds(root_);
+}
+
+template <typename T, std::size_t N>
+void RTree<T, N>::clear() {
+    nodes_.clear();
+    free_nodes_.clear();
+    root_ = npos;
+    size_ = 0;
+}
+
+#endif // RTREE_TPP
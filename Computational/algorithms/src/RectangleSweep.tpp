@@ -0,0 +1,151 @@
+#ifndef RECTANGLESWEEP_TPP
+#define RECTANGLESWEEP_TPP
+
+#include "../include/RectangleSweep.hpp"
+#include <algorithm>
+#include <cmath>
+
+template <typename T>
+typename RectangleSweep<T>::UnionMeasure RectangleSweep<T>::union_measure(const std::vector<box_t>& boxes) {
+    UnionMeasure result;
+    compress_ys(boxes, false);
+    if (ys_.size() < 2) {
+        return result;
+    }
+
+    // Elementary intervals [ys_[i], ys_[i + 1])
+    std::vector<T> weights(ys_.size() - 1);
+    for (std::size_t i = 0; i + 1 < ys_.size(); ++i) {
+        weights[i] = ys_[i + 1] - ys_[i];
+    }
+    tree_.build(weights);
+
+    events_.clear();
+    events_.reserve(2 * boxes.size());
+    for (const auto& box : boxes) {
+        const T x0 = static_cast<T>(box.min()[0]), x1 = static_cast<T>(box.max()[0]);
+        const T y0 = static_cast<T>(box.min()[1]), y1 = static_cast<T>(box.max()[1]);
+        if (!(x0 < x1) || !(y0 < y1)) {
+            continue;
+        }
+
+        const std::size_t first = y_index(y0);
+        const std::size_t last = y_index(y1) - 1;
+        events_.push_back(Event{x0, -1, first, last});
+        events_.push_back(Event{x1, 1, first, last});
+    }
+    std::sort(events_.begin(), events_.end());
+
+    // Adds before removals at the same x, so boxes that only touch leave no
+    // vertical edge between them
+    T x = events_.front().x;
+    for (const Event& event : events_) {
+        const double dx = static_cast<double>(event.x - x);
+        result.area += static_cast<double>(tree_.covered()) * dx;
+        result.perimeter += 2 * static_cast<double>(tree_.covered_runs()) * dx;
+        x = event.x;
+
+        const double before = static_cast<double>(tree_.covered());
+        tree_.add(event.first, event.last, -event.kind);
+        result.perimeter += std::abs(static_cast<double>(tree_.covered()) - before);
+    }
+
+    return result;
+}
+
+template <typename T>
+double RectangleSweep<T>::union_area(const std::vector<box_t>& boxes) {
+    return union_measure(boxes).area;
+}
+
+template <typename T>
+double RectangleSweep<T>::union_perimeter(const std::vector<box_t>& boxes) {
+    return union_measure(boxes).perimeter;
+}
+
+template <typename T>
+std::vector<std::size_t> RectangleSweep<T>::stabbing_counts(const std::vector<box_t>& boxes,
+                                                           const std::vector<point_t>& points) {
+    std::vector<std::size_t> counts(points.size(), 0);
+    compress_ys(boxes, true);
+    if (ys_.empty() || points.empty()) {
+        return counts;
+    }
+
+    // Closed boxes: every distinct y is an atom of its own (even slots), with
+    // the open gaps between them in the odd slots
+    tree_.build(2 * ys_.size() - 1);
+
+    events_.clear();
+    events_.reserve(2 * boxes.size() + points.size());
+    for (const auto& box : boxes) {
+        if (box.empty()) {
+            continue;
+        }
+
+        const std::size_t first = 2 * y_index(static_cast<T>(box.min()[1]));
+        const std::size_t last = 2 * y_index(static_cast<T>(box.max()[1]));
+        events_.push_back(Event{static_cast<T>(box.min()[0]), -1, first, last});
+        events_.push_back(Event{static_cast<T>(box.max()[0]), 1, first, last});
+    }
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        events_.push_back(Event{static_cast<T>(points[i][0]), 0, i, 0});
+    }
+    std::sort(events_.begin(), events_.end());
+
+    for (const Event& event : events_) {
+        if (event.kind != 0) {
+            tree_.add(event.first, event.last, -event.kind);
+            continue;
+        }
+
+        const T y = static_cast<T>(points[event.first][1]);
+        const std::size_t i = static_cast<std::size_t>(std::lower_bound(ys_.begin(), ys_.end(), y) - ys_.begin());
+        if (i < ys_.size() && ys_[i] == y) {
+            counts[event.first] = static_cast<std::size_t>(tree_.count(2 * i));
+        }
+        else if (i > 0 && i < ys_.size()) {
+            counts[event.first] = static_cast<std::size_t>(tree_.count(2 * i - 1));
+        }
+    }
+
+    return counts;
+}
+
+template <typename T>
+void RectangleSweep<T>::clear() {
+    ys_.clear();
+    events_.clear();
+    tree_.clear();
+}
+
+/*
+================================================================================================================
+                                Helpers
+================================================================================================================
+*/
+template <typename T>
+void RectangleSweep<T>::compress_ys(const std::vector<box_t>& boxes, bool closed) {
+    ys_.clear();
+    ys_.reserve(2 * boxes.size());
+    for (const auto& box : boxes) {
+        const T y0 = static_cast<T>(box.min()[1]), y1 = static_cast<T>(box.max()[1]);
+        const bool keep = closed
+            ? !box.empty()
+            : static_cast<T>(box.min()[0]) < static_cast<T>(box.max()[0]) && y0 < y1;
+        if (keep) {
+            ys_.push_back(y0);
+            ys_.push_back(y1);
+        }
+    }
+
+    std::sort(ys_.begin(), ys_.end());
+    ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+}
+
+template <typename T>
+std::size_t RectangleSweep<T>::y_index(T y) const {
+    return static_cast<std::size_t>(std::lower_bound(ys_.begin(), ys_.end(), y) - ys_.begin());
+}
+
+#endif // RECTANGLESWEEP_TPP
@@ -276,10 +276,171 @@ typename SegmentTree<T, Op>::size_type SegmentTree<T, Op>::height() const {
 template <typename T, typename Op>
 typename SegmentTree<T, Op>::size_type SegmentTree<T, Op>::height_internal(const node_type* node) const {
     if (!node) {
-        return 0
-    };
+        return 0;
+    }
     
     return 1 + std::max(height_internal(node->left.get()), height_internal(node->right.get()));
 }
 
+/*
+================================================================================================================
+                                Cover Segment Tree
+================================================================================================================
+*/
+template <typename T>
+CoverSegmentTree<T>::CoverSegmentTree(size_type n) {
+    build(n);
+}
+
+template <typename T>
+CoverSegmentTree<T>::CoverSegmentTree(const std::vector<T>& weights) {
+    build(weights);
+}
+
+template <typename T>
+void CoverSegmentTree<T>::build(const std::vector<T>& weights) {
+    n_ = weights.size();
+    allocate();
+    if (n_ > 0) {
+        build_internal(&weights, 1, 0, n_ - 1);
+    }
+}
+
+template <typename T>
+void CoverSegmentTree<T>::build(size_type n) {
+    n_ = n;
+    allocate();
+    if (n_ > 0) {
+        build_internal(nullptr, 1, 0, n_ - 1);
+    }
+}
+
+template <typename T>
+void CoverSegmentTree<T>::allocate() {
+    // Halving splits keep every heap index below twice the next power of two
+    size_type capacity = 1;
+    while (capacity < n_) {
+        capacity <<= 1;
+    }
+    nodes_.assign(n_ > 0 ? 2 * capacity : 0, Node{});
+}
+
+template <typename T>
+void CoverSegmentTree<T>::build_internal(const std::vector<T>* weights, size_type node,
+                                         size_type left, size_type right) {
+    if (left == right) {
+        nodes_[node].full = weights ? (*weights)[left] : static_cast<T>(1);
+        return;
+    }
+
+    size_type mid = left + (right - left) / 2;
+    build_internal(weights, 2 * node, left, mid);
+    build_internal(weights, 2 * node + 1, mid + 1, right);
+    nodes_[node].full = nodes_[2 * node].full + nodes_[2 * node + 1].full;
+}
+
+template <typename T>
+void CoverSegmentTree<T>::add(size_type left, size_type right, int delta) {
+    assert(left <= right && right < n_ && "Invalid range");
+    add_internal(1, 0, n_ - 1, left, right, delta);
+}
+
+template <typename T>
+void CoverSegmentTree<T>::add_internal(size_type node, size_type left, size_type right,
+                                       size_type from, size_type to, int delta) {
+    if (to < left || from > right) {
+        return;
+    }
+
+    // Complete overlap: the count stays here
+    if (from <= left && right <= to) {
+        nodes_[node].count += delta;
+        pull(node, left, right);
+        return;
+    }
+
+    size_type mid = left + (right - left) / 2;
+    add_internal(2 * node, left, mid, from, to, delta);
+    add_internal(2 * node + 1, mid + 1, right, from, to, delta);
+    pull(node, left, right);
+}
+
+template <typename T>
+void CoverSegmentTree<T>::pull(size_type node, size_type left, size_type right) {
+    Node& n = nodes_[node];
+    if (n.count > 0) {
+        n.covered = n.full;
+        n.runs = 1;
+        n.left_covered = n.right_covered = true;
+        return;
+    }
+    if (left == right) {
+        n.covered = T{};
+        n.runs = 0;
+        n.left_covered = n.right_covered = false;
+        return;
+    }
+
+    // Runs touching across the midpoint merge into one
+    const Node& l = nodes_[2 * node];
+    const Node& r = nodes_[2 * node + 1];
+    n.covered = l.covered + r.covered;
+    n.runs = l.runs + r.runs - (l.right_covered && r.left_covered ? 1 : 0);
+    n.left_covered = l.left_covered;
+    n.right_covered = r.right_covered;
+}
+
+template <typename T>
+T CoverSegmentTree<T>::covered() const {
+    return n_ > 0 ? nodes_[1].covered : T{};
+}
+
+template <typename T>
+typename CoverSegmentTree<T>::size_type CoverSegmentTree<T>::covered_runs() const {
+    return n_ > 0 ? nodes_[1].runs : 0;
+}
+
+template <typename T>
+long long CoverSegmentTree<T>::count(size_type index) const {
+    assert(index < n_ && "Index out of bounds");
+
+    // Counts are never pushed down: sum them along the root-to-leaf path
+    long long total = 0;
+    size_type node = 1, left = 0, right = n_ - 1;
+    while (true) {
+        total += nodes_[node].count;
+        if (left == right) {
+            break;
+        }
+
+        size_type mid = left + (right - left) / 2;
+        if (index <= mid) {
+            node = 2 * node;
+            right = mid;
+        }
+        else {
+            node = 2 * node + 1;
+            left = mid + 1;
+        }
+    }
+
+    return total;
+}
+
+template <typename T>
+typename CoverSegmentTree<T>::size_type CoverSegmentTree<T>::size() const {
+    return n_;
+}
+
+template <typename T>
+bool CoverSegmentTree<T>::empty() const {
+    return n_ == 0;
+}
+
+template <typename T>
+void CoverSegmentTree<T>::clear() {
+    nodes_.clear();
+    n_ = 0;
+}
+
 #endif // SEGMENTTREE_TPP
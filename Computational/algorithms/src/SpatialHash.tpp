@@ -0,0 +1,320 @@
+#ifndef SPATIALHASH_TPP
+#define SPATIALHASH_TPP
+
+#include "../include/SpatialHash.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+template <typename T>
+SpatialHashGrid<T>::SpatialHashGrid(T cell_size)
+    : cell_size_(cell_size), inv_cell_size_(1.0 / static_cast<double>(cell_size)) {
+    assert(cell_size > 0 && "Cell size must be positive");
+    rebuild();
+}
+
+template <typename T>
+SpatialHashGrid<T>::SpatialHashGrid(T cell_size, const std::vector<point_t>& points)
+    : SpatialHashGrid(cell_size) {
+    build(points);
+}
+
+template <typename T>
+typename SpatialHashGrid<T>::CellKey SpatialHashGrid<T>::cell_of(const point_t& p) const {
+    return CellKey{
+        static_cast<std::int64_t>(std::floor(static_cast<double>(static_cast<T>(p[0])) * inv_cell_size_)),
+        static_cast<std::int64_t>(std::floor(static_cast<double>(static_cast<T>(p[1])) * inv_cell_size_))
+    };
+}
+
+template <typename T>
+std::size_t SpatialHashGrid<T>::bucket_of(const CellKey& key) const {
+    // Teschner et al. spatial hash, followed by a multiplicative mix so that
+    // neighbouring cells spread over the whole table
+    auto h = static_cast<std::uint64_t>(key.x) * 73856093ULL ^ static_cast<std::uint64_t>(key.y) * 19349663ULL;
+    h *= 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<std::size_t>(h >> 32) & bucket_mask_;
+}
+
+/*
+================================================================================================================
+                                Construction / Updates
+================================================================================================================
+*/
+template <typename T>
+void SpatialHashGrid<T>::build(const std::vector<point_t>& points) {
+    positions_ = points;
+    cells_.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        cells_[i] = cell_of(points[i]);
+    }
+
+    rebuild();
+}
+
+template <typename T>
+void SpatialHashGrid<T>::update(const std::vector<point_t>& points) {
+    assert(points.size() == positions_.size() && "update() expects one position per existing id");
+    build(points);
+}
+
+template <typename T>
+void SpatialHashGrid<T>::rebuild() {
+    const std::size_t n = positions_.size();
+
+    // Keep the load factor at or below 1/2
+    std::size_t bucket_count = 16;
+    while (bucket_count < 2 * n) {
+        bucket_count <<= 1;
+    }
+    bucket_mask_ = bucket_count - 1;
+
+    // Counting sort of ids by bucket
+    bucket_start_.assign(bucket_count + 1, 0);
+    std::vector<std::size_t> bucket_ids(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        bucket_ids[i] = bucket_of(cells_[i]);
+        ++bucket_start_[bucket_ids[i] + 1];
+    }
+
+    for (std::size_t b = 0; b < bucket_count; ++b) {
+        bucket_start_[b + 1] += bucket_start_[b];
+    }
+
+    bucket_items_.resize(n);
+    std::vector<std::size_t> cursor(bucket_start_.begin(), bucket_start_.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        bucket_items_[cursor[bucket_ids[i]]++] = i;
+    }
+
+    overflow_slot_.assign(n, npos);
+    overflow_head_.assign(bucket_count, npos);
+    overflow_.clear();
+}
+
+template <typename T>
+void SpatialHashGrid<T>::push_overflow(std::size_t id) {
+    const std::size_t bucket = bucket_of(cells_[id]);
+    overflow_slot_[id] = overflow_.size();
+    overflow_.push_back(OverflowNode{id, overflow_head_[bucket]});
+    overflow_head_[bucket] = overflow_slot_[id];
+
+    // Amortize the O(n) re-sort over at least n/4 moves
+    if (overflow_.size() > positions_.size() / 4 + 64) {
+        rebuild();
+    }
+}
+
+template <typename T>
+std::size_t SpatialHashGrid<T>::insert(const point_t& p) {
+    const std::size_t id = positions_.size();
+    positions_.push_back(p);
+    cells_.push_back(cell_of(p));
+    overflow_slot_.push_back(npos);
+
+    // Grow the table once the load factor would exceed 1/2
+    if (2 * positions_.size() > bucket_mask_ + 1) {
+        rebuild();
+    }
+    else {
+        push_overflow(id);
+    }
+
+    return id;
+}
+
+template <typename T>
+void SpatialHashGrid<T>::move(std::size_t id, const point_t& p) {
+    assert(id < positions_.size() && "Point id out of range");
+    positions_[id] = p;
+
+    const CellKey key = cell_of(p);
+    if (key == cells_[id]) {
+        return;  // Common case for small time steps: storage untouched
+    }
+
+    cells_[id] = key;
+    push_overflow(id);
+}
+
+/*
+================================================================================================================
+                                Traversal
+================================================================================================================
+*/
+template <typename T>
+template <typename Visitor>
+void SpatialHashGrid<T>::for_each_in_bucket(std::size_t bucket, Visitor&& visit) const {
+    for (std::size_t i = bucket_start_[bucket]; i < bucket_start_[bucket + 1]; ++i) {
+        const std::size_t id = bucket_items_[i];
+        if (overflow_slot_[id] == npos) {
+            visit(id);
+        }
+    }
+
+    // Stale overflow nodes (the point moved again afterwards) are skipped
+    for (std::size_t node = overflow_head_[bucket]; node != npos; node = overflow_[node].next) {
+        const std::size_t id = overflow_[node].id;
+        if (overflow_slot_[id] == node) {
+            visit(id);
+        }
+    }
+}
+
+template <typename T>
+template <typename Visitor>
+void SpatialHashGrid<T>::for_each_in_cell(const CellKey& key, Visitor&& visit) const {
+    // Several cells may share a bucket, filter on the exact key
+    for_each_in_bucket(bucket_of(key), [&](std::size_t id) {
+        if (cells_[id] == key) {
+            visit(id);
+        }
+    });
+}
+
+/*
+================================================================================================================
+                                Queries
+================================================================================================================
+*/
+template <typename T>
+std::vector<std::size_t> SpatialHashGrid<T>::query_radius(const point_t& p, T radius) const {
+    std::vector<std::size_t> result;
+    query_radius(p, radius, result);
+
+    return result;
+}
+
+template <typename T>
+void SpatialHashGrid<T>::query_radius(const point_t& p, T radius, std::vector<std::size_t>& out) const {
+    if (positions_.empty()) {
+        return;
+    }
+
+    const auto px = static_cast<double>(static_cast<T>(p[0]));
+    const auto py = static_cast<double>(static_cast<T>(p[1]));
+    const auto r = static_cast<double>(radius);
+    const double r_sq = r * r;
+
+    const auto x0 = static_cast<std::int64_t>(std::floor((px - r) * inv_cell_size_));
+    const auto x1 = static_cast<std::int64_t>(std::floor((px + r) * inv_cell_size_));
+    const auto y0 = static_cast<std::int64_t>(std::floor((py - r) * inv_cell_size_));
+    const auto y1 = static_cast<std::int64_t>(std::floor((py + r) * inv_cell_size_));
+
+    for (std::int64_t cx = x0; cx <= x1; ++cx) {
+        for (std::int64_t cy = y0; cy <= y1; ++cy) {
+            for_each_in_cell(CellKey{cx, cy}, [&](std::size_t id) {
+                const auto dx = static_cast<double>(static_cast<T>(positions_[id][0])) - px;
+                const auto dy = static_cast<double>(static_cast<T>(positions_[id][1])) - py;
+                if (dx * dx + dy * dy <= r_sq) {
+                    out.push_back(id);
+                }
+            });
+        }
+    }
+}
+
+template <typename T>
+std::vector<typename SpatialHashGrid<T>::index_pair> SpatialHashGrid<T>::pairs_within(
+    T radius, std::size_t threads) const {
+
+    const std::size_t bucket_count = bucket_mask_ + 1;
+    const auto r = static_cast<double>(radius);
+    const double r_sq = r * r;
+    const auto ring = static_cast<std::int64_t>(std::ceil(r * inv_cell_size_));
+
+    // Each pair is reported once, by its smaller id
+    auto scan = [&](std::size_t first_bucket, std::size_t last_bucket, std::vector<index_pair>& out) {
+        for (std::size_t b = first_bucket; b < last_bucket; ++b) {
+            for_each_in_bucket(b, [&](std::size_t i) {
+                const CellKey key = cells_[i];
+                const auto px = static_cast<double>(static_cast<T>(positions_[i][0]));
+                const auto py = static_cast<double>(static_cast<T>(positions_[i][1]));
+
+                for (std::int64_t cx = key.x - ring; cx <= key.x + ring; ++cx) {
+                    for (std::int64_t cy = key.y - ring; cy <= key.y + ring; ++cy) {
+                        for_each_in_cell(CellKey{cx, cy}, [&](std::size_t j) {
+                            if (j <= i) {
+                                return;
+                            }
+
+                            const auto dx = static_cast<double>(static_cast<T>(positions_[j][0])) - px;
+                            const auto dy = static_cast<double>(static_cast<T>(positions_[j][1])) - py;
+                            if (dx * dx + dy * dy <= r_sq) {
+                                out.emplace_back(i, j);
+                            }
+                        });
+                    }
+                }
+            });
+        }
+    };
+
+    // Small inputs are not worth the thread start-up cost
+    threads = std::max<std::size_t>(1, threads);
+    if (positions_.size() < 4096) {
+        threads = 1;
+    }
+
+    std::vector<std::vector<index_pair>> partial(threads);
+    if (threads == 1) {
+        scan(0, bucket_count, partial[0]);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            const std::size_t first = bucket_count * t / threads;
+            const std::size_t last = bucket_count * (t + 1) / threads;
+            workers.emplace_back(scan, first, last, std::ref(partial[t]));
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t total = 0;
+    for (const auto& part : partial) {
+        total += part.size();
+    }
+
+    std::vector<index_pair> result;
+    result.reserve(total);
+    for (const auto& part : partial) {
+        result.insert(result.end(), part.begin(), part.end());
+    }
+
+    return result;
+}
+
+/*
+================================================================================================================
+                                Accessors
+================================================================================================================
+*/
+template <typename T>
+const typename SpatialHashGrid<T>::point_t& SpatialHashGrid<T>::position(std::size_t id) const {
+    assert(id < positions_.size() && "Point id out of range");
+    return positions_[id];
+}
+
+template <typename T>
+std::size_t SpatialHashGrid<T>::size() const {
+    return positions_.size();
+}
+
+template <typename T>
+T SpatialHashGrid<T>::cell_size() const {
+    return cell_size_;
+}
+
+template <typename T>
+void SpatialHashGrid<T>::clear() {
+    positions_.clear();
+    cells_.clear();
+    rebuild();
+}
+
+#endif // SPATIALHASH_TPP
@@ -17,8 +17,17 @@ Voronoi<T>::Voronoi(const Delaunay<T>& delaunay) {
 }
 
 template <typename T>
-void Voronoi<T>::compute(const std::vector<point_t>& sites) {
+void Voronoi<T>::compute(const std::vector<point_t>& sites, Method method) {
     clear();
+    if (method == Method::FortuneSweep || (method == Method::Automatic && sites.size() >= SWEEP_THRESHOLD)) {
+        sweep_.run(sites);
+        sites_ = sites;
+        mesh_pending_ = true;
+        from_sweep_ = true;
+        build_from_sweep();
+        return;
+    }
+
     delaunay_.triangulate(sites);
     build_from_delaunay();
 }
@@ -30,39 +39,580 @@ void Voronoi<T>::compute(const Delaunay<T>& delaunay) {
     build_from_delaunay();
 }
 
+template <typename T>
+void Voronoi<T>::set_thread_count(std::size_t threads) {
+    threads_ = std::max<std::size_t>(1, threads);
+}
+
+/*
+================================================================================================================
+                                Flat Cell Storage
+================================================================================================================
+*/
 template <typename T>
 void Voronoi<T>::build_from_delaunay() {
-    const auto& triangles = delaunay_.triangles();
-    const auto& points = delaunay_.points();
+    const std::size_t n = delaunay_.points().size();
+    vertex_slices_.assign(n, Slice{});
+    neighbor_slices_.assign(n, Slice{});
+    bounded_.assign(n, 1);
+    dead_vertices_ = 0;
+    dead_neighbors_ = 0;
+
+    // Sizing pass: a cell has at most one vertex and one neighbour per fan
+    // entry, plus room for the vertices a box clip can add (and for the ray
+    // exits and box corners that close an open fan first)
+    parallel_for(n, [this](std::size_t first, std::size_t last, Scratch& scratch) {
+        for (std::size_t i = first; i < last; ++i) {
+            delaunay_.vertex_neighbors(i, scratch.ring);
+            const bool is_open = std::find(scratch.ring.begin(), scratch.ring.end(), Delaunay<T>::npos) != scratch.ring.end();
+            vertex_slices_[i].capacity = scratch.ring.size() + CLIP_SLACK + (is_open && is_clipped_ ? 2 * CLIP_SLACK : 0);
+            neighbor_slices_[i].capacity = scratch.ring.size();
+        }
+    });
+
+    std::size_t vertex_total = 0;
+    std::size_t neighbor_total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        vertex_slices_[i].offset = vertex_total;
+        neighbor_slices_[i].offset = neighbor_total;
+        vertex_total += vertex_slices_[i].capacity;
+        neighbor_total += neighbor_slices_[i].capacity;
+    }
+    cell_vertices_.assign(vertex_total, point_t{});
+    cell_neighbors_.assign(neighbor_total, 0);
+
+    // Fill pass: every cell writes only into its own slices
+    parallel_for(n, [this](std::size_t first, std::size_t last, Scratch& scratch) {
+        for (std::size_t i = first; i < last; ++i) {
+            refill_cell(i, scratch);
+        }
+    });
+    relocate_overflow();
+
+    cells_dirty_ = true;
+    edges_dirty_ = true;
+}
+
+template <typename T>
+void Voronoi<T>::relocate_overflow() {
+    // Rare: a cell that no longer fits its slice is rebuilt serially
+    for (Scratch& scratch : scratch_) {
+        for (std::size_t i : scratch.overflow) {
+            update_cell(i);
+        }
+        scratch.overflow.clear();
+    }
+}
+
+template <typename T>
+void Voronoi<T>::build_from_sweep() {
+    const auto& points = sites();
+    const auto& vertices = sweep_.vertices();
+    const auto& edges = sweep_.edges();
+    const std::size_t n = points.size();
+    vertex_slices_.assign(n, Slice{});
+    neighbor_slices_.assign(n, Slice{});
+    bounded_.assign(n, 1);
+    dead_vertices_ = 0;
+    dead_neighbors_ = 0;
+
+    // Sizing pass: a Voronoi vertex belongs to the three sites on its circle,
+    // an edge to the two sites it separates
+    for (const auto& vertex : vertices) {
+        for (std::size_t site : vertex.sites) {
+            ++vertex_slices_[site].size;
+        }
+    }
+    for (const auto& edge : edges) {
+        ++neighbor_slices_[edge.left].size;
+        ++neighbor_slices_[edge.right].size;
+        if (edge.ends[0] == FortuneSweep<T>::npos || edge.ends[1] == FortuneSweep<T>::npos) {
+            bounded_[edge.left] = 0;
+            bounded_[edge.right] = 0;
+        }
+    }
+    if (edges.empty() && n > 0) {
+        bounded_[0] = 0;  // A lone site (repeats keep the lowest index) owns the plane
+    }
+
+    // Clipped, an unbounded cell is closed with the rays of its open edges
+    // (both halves of a full line), kept per site like the slices
+    std::vector<std::size_t> ray_offsets;
+    std::vector<edge_t> rays;
+    if (is_clipped_) {
+        ray_offsets.assign(n + 1, 0);
+        for (const auto& edge : edges) {
+            const std::size_t open = (edge.ends[0] == FortuneSweep<T>::npos) + (edge.ends[1] == FortuneSweep<T>::npos);
+            ray_offsets[edge.left + 1] += open;
+            ray_offsets[edge.right + 1] += open;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            ray_offsets[i + 1] += ray_offsets[i];
+        }
+
+        rays.resize(ray_offsets[n]);
+        std::vector<std::size_t> filled(ray_offsets.begin(), ray_offsets.end() - 1);
+        for (const auto& edge : edges) {
+            const bool closed0 = edge.ends[0] != FortuneSweep<T>::npos;
+            const bool closed1 = edge.ends[1] != FortuneSweep<T>::npos;
+            if (closed0 && closed1) {
+                continue;
+            }
+
+            auto add = [&](const edge_t& ray) {
+                rays[filled[edge.left]++] = ray;
+                rays[filled[edge.right]++] = ray;
+            };
+            if (closed0 || closed1) {
+                const auto dir = sweep_.direction(edge, closed0 ? 1 : 0);
+                const auto& origin = vertices[edge.ends[closed0 ? 0 : 1]].position;
+                add(edge_t::infinite(point_t{static_cast<T>(origin[0]), static_cast<T>(origin[1])},
+                                     point_t{static_cast<T>(dir[0]), static_cast<T>(dir[1])}));
+            }
+            else {
+                const point_t& a = points[edge.left];
+                const point_t& b = points[edge.right];
+                const point_t mid{(static_cast<T>(a[0]) + static_cast<T>(b[0])) / 2, (static_cast<T>(a[1]) + static_cast<T>(b[1])) / 2};
+                const T dx = static_cast<T>(b[0]) - static_cast<T>(a[0]);
+                const T dy = static_cast<T>(b[1]) - static_cast<T>(a[1]);
+                add(edge_t::infinite(mid, point_t{-dy, dx}));
+                add(edge_t::infinite(mid, point_t{dy, -dx}));
+            }
+        }
+    }
+
+    std::size_t vertex_total = 0;
+    std::size_t neighbor_total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // Closing adds the ray exits and up to four corners
+        const std::size_t closing = is_clipped_ ? ray_offsets[i + 1] - ray_offsets[i] + CLIP_SLACK : 0;
+        vertex_slices_[i] = Slice{vertex_total, 0, vertex_slices_[i].size + CLIP_SLACK + closing};
+        neighbor_slices_[i] = Slice{neighbor_total, 0, neighbor_slices_[i].size};
+        vertex_total += vertex_slices_[i].capacity;
+        neighbor_total += neighbor_slices_[i].capacity;
+    }
+    cell_vertices_.assign(vertex_total, point_t{});
+    cell_neighbors_.assign(neighbor_total, 0);
+
+    for (const auto& vertex : vertices) {
+        const point_t p{static_cast<T>(vertex.position[0]), static_cast<T>(vertex.position[1])};
+        for (std::size_t site : vertex.sites) {
+            Slice& vs = vertex_slices_[site];
+            cell_vertices_[vs.offset + vs.size++] = p;
+        }
+    }
+    for (const auto& edge : edges) {
+        Slice& left = neighbor_slices_[edge.left];
+        Slice& right = neighbor_slices_[edge.right];
+        cell_neighbors_[left.offset + left.size++] = edge.right;
+        cell_neighbors_[right.offset + right.size++] = edge.left;
+    }
+
+    // Cells are convex around their site, so sorting by angle gives the CCW
+    // order. The pseudo-angle is monotone in the true angle and needs no trig.
+    auto pseudo_angle = [](double dx, double dy) {
+        const double p = dx / (std::abs(dx) + std::abs(dy));
+        return dy < 0 ? 3 + p : 1 - p;
+    };
+    parallel_for(n, [this, &points, &pseudo_angle, &ray_offsets, &rays](std::size_t first, std::size_t last, Scratch& scratch) {
+        for (std::size_t i = first; i < last; ++i) {
+            const double sx = static_cast<double>(static_cast<T>(points[i][0]));
+            const double sy = static_cast<double>(static_cast<T>(points[i][1]));
+            auto by_angle = [&](const point_t& a, const point_t& b) {
+                return pseudo_angle(static_cast<double>(static_cast<T>(a[0])) - sx, static_cast<double>(static_cast<T>(a[1])) - sy)
+                     < pseudo_angle(static_cast<double>(static_cast<T>(b[0])) - sx, static_cast<double>(static_cast<T>(b[1])) - sy);
+            };
+
+            const Slice& vs = vertex_slices_[i];
+            std::sort(cell_vertices_.begin() + vs.offset, cell_vertices_.begin() + vs.offset + vs.size, by_angle);
+
+            const Slice& ns = neighbor_slices_[i];
+            std::sort(cell_neighbors_.begin() + ns.offset, cell_neighbors_.begin() + ns.offset + ns.size,
+                      [&](std::size_t a, std::size_t b) { return by_angle(points[a], points[b]); });
+
+            if (!is_clipped_) {
+                continue;
+            }
+
+            // The cell, closed inside a box around its finite part, is convex
+            // around the site: the ray exits and the box corners no neighbour
+            // is closer to join its vertices in the angular order
+            Slice& cell = vertex_slices_[i];
+            auto& polygon = scratch.polygon;
+            polygon.assign(cell_vertices_.begin() + cell.offset, cell_vertices_.begin() + cell.offset + cell.size);
+            if (!bounded_[i]) {
+                const BoundingBox<T, 2> box = closing_box(points[i], polygon);
+                for (std::size_t r = ray_offsets[i]; r < ray_offsets[i + 1]; ++r) {
+                    polygon.push_back(clip_infinite_edge(rays[r], box));
+                }
+
+                auto distance_sq = [](const point_t& a, const point_t& b) {
+                    const double dx = static_cast<double>(static_cast<T>(a[0])) - static_cast<double>(static_cast<T>(b[0]));
+                    const double dy = static_cast<double>(static_cast<T>(a[1])) - static_cast<double>(static_cast<T>(b[1]));
+                    return dx * dx + dy * dy;
+                };
+                auto min_pt = box.min();
+                auto max_pt = box.max();
+                for (const point_t& corner : {point_t{static_cast<T>(min_pt[0]), static_cast<T>(min_pt[1])},
+                                              point_t{static_cast<T>(max_pt[0]), static_cast<T>(min_pt[1])},
+                                              point_t{static_cast<T>(max_pt[0]), static_cast<T>(max_pt[1])},
+                                              point_t{static_cast<T>(min_pt[0]), static_cast<T>(max_pt[1])}}) {
+                    const double own = distance_sq(corner, points[i]);
+                    bool inside = true;
+                    for (std::size_t k = 0; k < ns.size && inside; ++k) {
+                        inside = own <= distance_sq(corner, points[cell_neighbors_[ns.offset + k]]);
+                    }
+                    if (inside) {
+                        polygon.push_back(corner);
+                    }
+                }
+                std::sort(polygon.begin(), polygon.end(), by_angle);
+            }
+
+            clip_polygon(polygon, scratch.clipped, bounds_);
+            std::copy(polygon.begin(), polygon.end(), cell_vertices_.begin() + cell.offset);
+            cell.size = polygon.size();
+        }
+    });
+
+    cells_dirty_ = true;
+    edges_dirty_ = true;
+}
+
+template <typename T>
+const std::vector<typename Voronoi<T>::point_t>& Voronoi<T>::sites() const {
+    return mesh_pending_ ? sites_ : delaunay_.points();
+}
+
+template <typename T>
+const Delaunay<T>& Voronoi<T>::mesh() const {
+    if (mesh_pending_) {
+        delaunay_.triangulate(sites_);
+        std::vector<point_t>().swap(sites_);
+        mesh_pending_ = false;
+    }
+
+    return delaunay_;
+}
+
+template <typename T>
+void Voronoi<T>::prepare_update() {
+    // Updates go through the triangulation. A swept diagram is rebuilt as its
+    // dual first so that updated and untouched cells agree near the hull.
+    if (from_sweep_) {
+        mesh();
+        sweep_.clear();
+        from_sweep_ = false;
+        build_from_delaunay();  // Re-clips if needed
+    }
+}
+
+template <typename T>
+bool Voronoi<T>::gather_cell(std::size_t site_idx, Scratch& scratch) const {
+    constexpr std::size_t npos = Delaunay<T>::npos;
+    const Delaunay<T>& delaunay = mesh();
+    const auto& points = delaunay.points();
+    const point_t& site = points[site_idx];
+
+    // The fan around the site is CCW, so consecutive circumcenters already
+    // trace the cell boundary in order. Sites next to the super-triangle
+    // (on the hull) have an open fan and an unbounded cell; walking it from
+    // just after its last gap keeps every run of neighbours in one piece.
+    delaunay.vertex_neighbors(site_idx, scratch.ring);
+    auto& ring = scratch.ring;
+    auto& polygon = scratch.polygon;
+    auto& runs = scratch.runs;
+    const std::size_t m = ring.size();
+    std::size_t start = 0;
+    bool is_bounded = true;
+    for (std::size_t k = 0; k < m; ++k) {
+        if (ring[k] == npos) {
+            start = (k + 1) % m;
+            is_bounded = false;
+        }
+    }
+
+    // A run is stored as its first and last neighbour with the range of its
+    // circumcenters: first, begin, last, end
+    polygon.clear();
+    runs.clear();
+    for (std::size_t j = 0; j < m; ++j) {
+        const std::size_t a = ring[(start + j) % m];
+        const std::size_t b = ring[(start + j + 1) % m];
+        if (a == npos) {
+            continue;
+        }
+
+        if (!is_bounded && ring[(start + j + m - 1) % m] == npos) {
+            runs.push_back(a);
+            runs.push_back(polygon.size());
+        }
+        if (b != npos) {
+            polygon.push_back(Triangle<T, 2>(site, points[a], points[b]).circumcenter());
+        }
+        else {
+            runs.push_back(a);
+            runs.push_back(polygon.size());
+        }
+    }
+
+    if (!is_bounded && is_clipped_) {
+        // Close the cell inside a box that holds the bounds and all of its
+        // finite part. Each run lies between the exits of two outward
+        // bisector rays (from its end circumcenters, or from the midpoint to
+        // a lone neighbour); the box corners fill in from one run's last
+        // exit to the next run's first.
+        const BoundingBox<T, 2> box = closing_box(site, polygon);
+        auto ray_exit = [&](std::size_t run, bool outgoing) {
+            const std::size_t neighbor = runs[4 * run + (outgoing ? 2 : 0)];
+            const std::size_t begin = runs[4 * run + 1];
+            const std::size_t end = runs[4 * run + 3];
+            const point_t& q = points[neighbor];
+            const T dx = static_cast<T>(q[0]) - static_cast<T>(site[0]);
+            const T dy = static_cast<T>(q[1]) - static_cast<T>(site[1]);
+            const point_t origin = begin == end
+                ? point_t{(static_cast<T>(q[0]) + static_cast<T>(site[0])) / 2, (static_cast<T>(q[1]) + static_cast<T>(site[1])) / 2}
+                : polygon[outgoing ? end - 1 : begin];
+            const point_t direction = outgoing ? point_t{-dy, dx} : point_t{dy, -dx};
+
+            return clip_infinite_edge(edge_t::infinite(origin, direction), box);
+        };
+
+        auto& closed = scratch.clipped;
+        closed.clear();
+        const std::size_t run_count = runs.size() / 4;
+        for (std::size_t r = 0; r < run_count; ++r) {
+            closed.push_back(ray_exit(r, false));
+            closed.insert(closed.end(), polygon.begin() + static_cast<std::ptrdiff_t>(runs[4 * r + 1]),
+                          polygon.begin() + static_cast<std::ptrdiff_t>(runs[4 * r + 3]));
+            const point_t exit = ray_exit(r, true);
+            closed.push_back(exit);
+            append_corners(closed, exit, ray_exit((r + 1) % run_count, false), box);
+        }
+        if (run_count == 0 && m > 0) {
+            // A lone site: its cell is everything
+            closed.push_back(box.min());
+            append_corners(closed, box.min(), box.min(), box);
+        }
+        polygon.swap(closed);
+    }
+
+    // What is left of the fan is the neighbour list
+    ring.erase(std::remove(ring.begin(), ring.end(), Delaunay<T>::npos), ring.end());
+
+    return is_bounded;
+}
+
+template <typename T>
+template <typename U>
+void Voronoi<T>::store_slice(std::vector<U>& flat, Slice& slice, const std::vector<U>& data,
+                             std::size_t slack, std::size_t& dead) {
+    // Grown slices move to the end; the old space is reclaimed by compact()
+    if (data.size() > slice.capacity) {
+        dead += slice.capacity;
+        slice.offset = flat.size();
+        slice.capacity = data.size() + slack;
+        flat.resize(flat.size() + slice.capacity);
+    }
+
+    std::copy(data.begin(), data.end(), flat.begin() + slice.offset);
+    slice.size = data.size();
+}
+
+template <typename T>
+void Voronoi<T>::refill_cell(std::size_t site_idx, Scratch& scratch) {
+    // Thread-safe: touches only this cell's slices. A cell that no longer
+    // fits is left for relocate_overflow()
+    bounded_[site_idx] = gather_cell(site_idx, scratch);
+    if (is_clipped_) {
+        clip_polygon(scratch.polygon, scratch.clipped, bounds_);
+    }
 
-    if (triangles.empty() || points.empty()) {
+    Slice& vs = vertex_slices_[site_idx];
+    Slice& ns = neighbor_slices_[site_idx];
+    if (scratch.polygon.size() > vs.capacity || scratch.ring.size() > ns.capacity) {
+        scratch.overflow.push_back(site_idx);
         return;
     }
 
-    // Compute circumcenters (Voronoi vertices)
-    vertices_.clear();
-    for (const auto& tri : triangles) {
-        vertices_.push_back(tri.circumcenter());
+    std::copy(scratch.polygon.begin(), scratch.polygon.end(), cell_vertices_.begin() + vs.offset);
+    vs.size = scratch.polygon.size();
+    std::copy(scratch.ring.begin(), scratch.ring.end(), cell_neighbors_.begin() + ns.offset);
+    ns.size = scratch.ring.size();
+}
+
+template <typename T>
+void Voronoi<T>::update_cell(std::size_t site_idx) {
+    if (site_idx >= vertex_slices_.size()) {
+        return;
     }
 
-    // Create a cell for each site
-    cells_.resize(points.size());
-    for (std::size_t i = 0; i < points.size(); ++i) {
+    if (scratch_.empty()) {
+        scratch_.resize(1);
+    }
+    Scratch& scratch = scratch_.front();
+
+    bounded_[site_idx] = gather_cell(site_idx, scratch);
+    if (is_clipped_) {
+        clip_polygon(scratch.polygon, scratch.clipped, bounds_);
+    }
+
+    store_slice(cell_vertices_, vertex_slices_[site_idx], scratch.polygon, CLIP_SLACK, dead_vertices_);
+    store_slice(cell_neighbors_, neighbor_slices_[site_idx], scratch.ring, 0, dead_neighbors_);
+}
+
+template <typename T>
+void Voronoi<T>::update_cells(const std::vector<std::size_t>& sites) {
+    const std::size_t n = delaunay_.points().size();
+    if (vertex_slices_.size() < n) {
+        // New cells start without storage and get appended on first store
+        vertex_slices_.resize(n, Slice{});
+        neighbor_slices_.resize(n, Slice{});
+        bounded_.resize(n, 1);
+    }
+
+    parallel_for(sites.size(), [this, &sites](std::size_t first, std::size_t last, Scratch& scratch) {
+        for (std::size_t k = first; k < last; ++k) {
+            if (sites[k] < vertex_slices_.size()) {
+                refill_cell(sites[k], scratch);
+            }
+        }
+    });
+    relocate_overflow();
+
+    if (dead_vertices_ > cell_vertices_.size() / 2 || dead_neighbors_ > cell_neighbors_.size() / 2) {
+        compact();
+    }
+
+    cells_dirty_ = true;
+    edges_dirty_ = true;
+}
+
+template <typename T>
+void Voronoi<T>::compact() {
+    std::vector<point_t> vertices;
+    std::vector<std::size_t> neighbors;
+    std::size_t vertex_total = 0;
+    std::size_t neighbor_total = 0;
+    for (std::size_t i = 0; i < vertex_slices_.size(); ++i) {
+        vertex_total += vertex_slices_[i].size + CLIP_SLACK;
+        neighbor_total += neighbor_slices_[i].size;
+    }
+    vertices.reserve(vertex_total);
+    neighbors.reserve(neighbor_total);
+
+    for (std::size_t i = 0; i < vertex_slices_.size(); ++i) {
+        Slice& vs = vertex_slices_[i];
+        const std::size_t vertex_offset = vertices.size();
+        vertices.insert(vertices.end(), cell_vertices_.begin() + vs.offset,
+                        cell_vertices_.begin() + vs.offset + vs.size);
+        vertices.resize(vertices.size() + CLIP_SLACK);
+        vs = Slice{vertex_offset, vs.size, vs.size + CLIP_SLACK};
+
+        Slice& ns = neighbor_slices_[i];
+        const std::size_t neighbor_offset = neighbors.size();
+        neighbors.insert(neighbors.end(), cell_neighbors_.begin() + ns.offset,
+                         cell_neighbors_.begin() + ns.offset + ns.size);
+        ns = Slice{neighbor_offset, ns.size, ns.size};
+    }
+
+    cell_vertices_ = std::move(vertices);
+    cell_neighbors_ = std::move(neighbors);
+    dead_vertices_ = 0;
+    dead_neighbors_ = 0;
+}
+
+template <typename T>
+template <typename Fn>
+void Voronoi<T>::parallel_for(std::size_t n, Fn&& fn) {
+    // Cells are independent, so contiguous chunks need no synchronisation
+    constexpr std::size_t MIN_CELLS_PER_THREAD = 1024;
+    const std::size_t threads = std::max<std::size_t>(1, std::min(threads_, n / MIN_CELLS_PER_THREAD));
+    if (scratch_.size() < threads) {
+        scratch_.resize(threads);
+    }
+
+    if (threads == 1) {
+        fn(std::size_t{0}, n, scratch_.front());
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back([this, &fn, n, t, threads] {
+            fn(n * t / threads, n * (t + 1) / threads, scratch_[t]);
+        });
+    }
+    fn(std::size_t{0}, n / threads, scratch_.front());
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename T>
+void Voronoi<T>::build_cells() const {
+    const auto& points = sites();
+    cells_.resize(vertex_slices_.size());
+    for (std::size_t i = 0; i < cells_.size(); ++i) {
+        const Slice& vs = vertex_slices_[i];
+        const Slice& ns = neighbor_slices_[i];
         cells_[i].site = points[i];
-        cells_[i].vertices.clear();
-        cells_[i].neighbor_cells.clear();
-        cells_[i].is_bounded = true;
-        site_to_cell_[i] = i;
+        cells_[i].vertices = Range<point_t>{cell_vertices_.data() + vs.offset, vs.size};
+        cells_[i].neighbor_cells = Range<std::size_t>{cell_neighbors_.data() + ns.offset, ns.size};
+        cells_[i].is_bounded = bounded_[i] != 0;
     }
 
-    // Build adjacency: for each site, find all triangles containing it
-    // The circumcenters of these triangles form the Voronoi cell vertices
-    for (std::size_t site_idx = 0; site_idx < points.size(); ++site_idx) {
-        compute_cell_vertices(site_idx);
+    cells_base_ = cell_vertices_.data();
+    cells_dirty_ = false;
+}
+
+template <typename T>
+void Voronoi<T>::build_edges() const {
+    if (from_sweep_) {
+        const auto& records = sweep_.edges();
+        vertices_.clear();
+        vertices_.reserve(sweep_.vertices().size());
+        for (const auto& vertex : sweep_.vertices()) {
+            vertices_.push_back(point_t{static_cast<T>(vertex.position[0]), static_cast<T>(vertex.position[1])});
+        }
+
+        // Full lines (collinear input) have no vertex to anchor them and are
+        // left out, as in the triangulation path
+        edges_.clear();
+        for (const auto& record : records) {
+            const bool closed0 = record.ends[0] != FortuneSweep<T>::npos;
+            const bool closed1 = record.ends[1] != FortuneSweep<T>::npos;
+            if (closed0 && closed1) {
+                edges_.emplace_back(vertices_[record.ends[0]], vertices_[record.ends[1]]);
+            }
+            else if (closed0 || closed1) {
+                const auto dir = sweep_.direction(record, closed0 ? 1 : 0);
+                const point_t origin = vertices_[record.ends[closed0 ? 0 : 1]];
+                const point_t perp{static_cast<T>(dir[0]), static_cast<T>(dir[1])};
+                if (is_clipped_) {
+                    edges_.emplace_back(origin, clip_infinite_edge(edge_t::infinite(origin, perp), bounds_));
+                }
+                else {
+                    edges_.push_back(edge_t::infinite(origin, perp));
+                }
+            }
+        }
+
+        edges_dirty_ = false;
+        return;
     }
 
-    // Identify unbounded cells (sites on convex hull)
-    identify_unbounded_cells();
+    const auto& triangles = delaunay_.triangles();
+    const auto& adjacency = delaunay_.triangle_adjacency();
+
+    // Compute circumcenters (Voronoi vertices)
+    vertices_.clear();
+    vertices_.reserve(triangles.size());
+    for (const auto& tri : triangles) {
+        vertices_.push_back(tri.circumcenter());
+    }
 
     // Build Voronoi edges
     edges_.clear();
@@ -75,160 +625,269 @@ void Voronoi<T>::build_from_delaunay() {
             point_t p1 = tri.vertices[e];
             point_t p2 = tri.vertices[(e + 1) % 3];
 
-            // Find adjacent triangle sharing this edge
-            bool found_neighbor = false;
-            for (std::size_t j = i + 1; j < triangles.size(); ++j) {
-                const auto& other = triangles[j];
-                bool has_p1 = false, has_p2 = false;
-
-                for (int k = 0; k < 3; ++k) {
-                    if (other.vertices[k] == p1) has_p1 = true;
-                    if (other.vertices[k] == p2) has_p2 = true;
-                }
-
-                if (has_p1 && has_p2) {
-                    // Adjacent triangles - connect their circumcenters
+            // Adjacent triangles - connect their circumcenters (once per pair)
+            const std::size_t j = adjacency[i][(e + 2) % 3];
+            if (j != Delaunay<T>::npos) {
+                if (i < j) {
                     edges_.emplace_back(cc_i, vertices_[j]);
-                    found_neighbor = true;
-                    break;
                 }
+                continue;
             }
 
-            // If no neighbor found, this is a hull edge -> infinite Voronoi edge
-            if (!found_neighbor) {
-                // Create perpendicular bisector direction pointing outward
-                auto dx = static_cast<T>(p2[0]) - static_cast<T>(p1[0]);
-                auto dy = static_cast<T>(p2[1]) - static_cast<T>(p1[1]);
+            // No neighbor: this is a hull edge -> infinite Voronoi edge
+            // Create perpendicular bisector direction pointing outward
+            auto dx = static_cast<T>(p2[0]) - static_cast<T>(p1[0]);
+            auto dy = static_cast<T>(p2[1]) - static_cast<T>(p1[1]);
 
-                // Perpendicular direction
-                point_t perp{-dy, dx};
+            // Perpendicular direction
+            point_t perp{-dy, dx};
 
-                // Determine outward direction (away from third vertex)
-                auto third = tri.vertices[(e + 2) % 3];
-                point_t mid{(static_cast<T>(p1[0]) + static_cast<T>(p2[0])) / 2,
-                            (static_cast<T>(p1[1]) + static_cast<T>(p2[1])) / 2};
+            // Determine outward direction (away from third vertex)
+            auto third = tri.vertices[(e + 2) % 3];
+            point_t mid{(static_cast<T>(p1[0]) + static_cast<T>(p2[0])) / 2,
+                        (static_cast<T>(p1[1]) + static_cast<T>(p2[1])) / 2};
 
-                auto to_third_x = static_cast<T>(third[0]) - static_cast<T>(mid[0]);
-                auto to_third_y = static_cast<T>(third[1]) - static_cast<T>(mid[1]);
+            auto to_third_x = static_cast<T>(third[0]) - static_cast<T>(mid[0]);
+            auto to_third_y = static_cast<T>(third[1]) - static_cast<T>(mid[1]);
 
-                auto dot = static_cast<T>(perp[0]) * to_third_x + static_cast<T>(perp[1]) * to_third_y;
-                if (dot > 0) {
-                    perp = point_t{dy, -dx};  // Flip direction
-                }
+            auto dot = static_cast<T>(perp[0]) * to_third_x + static_cast<T>(perp[1]) * to_third_y;
+            if (dot > 0) {
+                perp = point_t{dy, -dx};  // Flip direction
+            }
 
+            if (is_clipped_) {
+                edges_.emplace_back(cc_i, clip_infinite_edge(edge_t::infinite(cc_i, perp), bounds_));
+            }
+            else {
                 edges_.push_back(edge_t::infinite(cc_i, perp));
             }
         }
     }
 
-    // Order vertices CCW for each cell
-    for (auto& cell : cells_) {
-        order_cell_vertices_ccw(cell);
-    }
+    edges_dirty_ = false;
 }
 
+/*
+================================================================================================================
+                                Local Updates
+================================================================================================================
+*/
 template <typename T>
-void Voronoi<T>::compute_cell_vertices(std::size_t site_idx) {
-    const auto& triangles = delaunay_.triangles();
-    const auto& points = delaunay_.points();
+void Voronoi<T>::insert(const point_t& site) {
+    prepare_update();
+    delaunay_.insert(site);
+    update_cells(delaunay_.changed_points());
+}
 
-    if (site_idx >= points.size()) {
-        return;
+template <typename T>
+bool Voronoi<T>::remove(const point_t& site) {
+    prepare_update();
+    const std::size_t idx = delaunay_.find(site);
+    if (idx == Delaunay<T>::npos || !delaunay_.remove(site)) {
+        return false;
     }
 
-    Cell& cell = cells_[site_idx];
-    const point_t& site = points[site_idx];
-
-    // Find all triangles containing this site
-    for (std::size_t i = 0; i < triangles.size(); ++i) {
-        const auto& tri = triangles[i];
-        bool contains_site = false;
-
-        for (int j = 0; j < 3; ++j) {
-            if (tri.vertices[j] == site) {
-                contains_site = true;
-                break;
+    // Same swap-and-pop as the triangulation; neighbours of the moved cell
+    // may be untouched by the update and still name its old index
+    const std::size_t moved_from = vertex_slices_.size() - 1;
+    dead_vertices_ += vertex_slices_[idx].capacity;
+    dead_neighbors_ += neighbor_slices_[idx].capacity;
+    if (idx != moved_from) {
+        vertex_slices_[idx] = vertex_slices_.back();
+        neighbor_slices_[idx] = neighbor_slices_.back();
+        bounded_[idx] = bounded_.back();
+
+        const Slice& moved = neighbor_slices_[idx];
+        for (std::size_t k = 0; k < moved.size; ++k) {
+            const std::size_t nb = cell_neighbors_[moved.offset + k];
+            if (nb < moved_from) {
+                const Slice& list = neighbor_slices_[nb];
+                auto first = cell_neighbors_.begin() + list.offset;
+                std::replace(first, first + list.size, moved_from, idx);
             }
         }
+    }
+    vertex_slices_.pop_back();
+    neighbor_slices_.pop_back();
+    bounded_.pop_back();
 
-        if (contains_site) {
-            cell.vertices.push_back(vertices_[i]);
-        }
+    update_cells(delaunay_.changed_points());
+
+    return true;
+}
+
+template <typename T>
+bool Voronoi<T>::move(const point_t& from, const point_t& to) {
+    prepare_update();
+    if (!delaunay_.move(from, to)) {
+        return false;
     }
+
+    update_cells(delaunay_.changed_points());
+
+    return true;
 }
 
+/*
+================================================================================================================
+                                Lloyd Relaxation
+================================================================================================================
+*/
 template <typename T>
-void Voronoi<T>::order_cell_vertices_ccw(Cell& cell) {
-    if (cell.vertices.size() < 3) {
-        return;
+std::size_t Voronoi<T>::relax(const BoundingBox<T, 2>& bounds, std::size_t max_iterations, T tolerance) {
+    clip_to_bounds(bounds);
+
+    return relax(max_iterations, tolerance);
+}
+
+template <typename T>
+std::size_t Voronoi<T>::relax(std::size_t max_iterations, T tolerance) {
+    prepare_update();
+    const double tolerance_sq = static_cast<double>(tolerance) * static_cast<double>(tolerance);
+
+    for (std::size_t iteration = 0; iteration < max_iterations; ++iteration) {
+        if (compute_centroids() <= tolerance_sq) {
+            return iteration;
+        }
+
+        // Jacobi step: every target comes from the previous diagram. Each
+        // site is relocated in place (indices are kept) and the cells of all
+        // touched fans are collected once for a single parallel refresh.
+        const std::size_t n = centroids_.size();
+        if (dirty_mark_.size() < n) {
+            dirty_mark_.resize(n, 0);
+        }
+        ++dirty_epoch_;
+        dirty_.clear();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (delaunay_.points()[i] == centroids_[i] || !delaunay_.move(i, centroids_[i])) {
+                continue;
+            }
+
+            for (std::size_t c : delaunay_.changed_points()) {
+                if (dirty_mark_[c] != dirty_epoch_) {
+                    dirty_mark_[c] = dirty_epoch_;
+                    dirty_.push_back(c);
+                }
+            }
+        }
+
+        update_cells(dirty_);
     }
 
-    // Compute centroid
-    auto cx = static_cast<T>(0);
-    auto cy = static_cast<T>(0);
-    for (const auto& v : cell.vertices) {
-        cx += static_cast<T>(v[0]);
-        cy += static_cast<T>(v[1]);
-    }
-    cx /= static_cast<T>(cell.vertices.size());
-    cy /= static_cast<T>(cell.vertices.size());
-
-    // Sort by angle from centroid
-    std::sort(cell.vertices.begin(), cell.vertices.end(),
-        [cx, cy](const point_t& a, const point_t& b) {
-            double angle_a = std::atan2(static_cast<double>(a[1]) - cy,
-                                        static_cast<double>(a[0]) - cx);
-            double angle_b = std::atan2(static_cast<double>(b[1]) - cy,
-                                        static_cast<double>(b[0]) - cx);
-            return angle_a < angle_b;
-        });
+    return max_iterations;
 }
 
 template <typename T>
-void Voronoi<T>::identify_unbounded_cells() {
-    // Sites on the convex hull have unbounded Voronoi cells
-    std::vector<point_t> hull = delaunay_.convex_hull();
-    const auto& points = delaunay_.points();
+double Voronoi<T>::compute_centroids() {
+    // Area centroid straight from the flat vertex slices; returns the
+    // largest squared distance from a site to its centroid
+    const auto& sites = delaunay_.points();
+    centroids_.resize(sites.size());
+    for (Scratch& scratch : scratch_) {
+        scratch.max_shift = 0;
+    }
 
-    for (std::size_t i = 0; i < points.size(); ++i) {
-        for (const auto& hp : hull) {
-            if (points[i] == hp) {
-                cells_[i].is_bounded = false;
-                break;
+    parallel_for(sites.size(), [this, &sites](std::size_t first, std::size_t last, Scratch& scratch) {
+        for (std::size_t i = first; i < last; ++i) {
+            centroids_[i] = sites[i];
+            const Slice& vs = vertex_slices_[i];
+            if (vs.size < 3 || (!bounded_[i] && !is_clipped_)) {
+                continue;
             }
+
+            const point_t* v = cell_vertices_.data() + vs.offset;
+            double area = 0;
+            double cx = 0;
+            double cy = 0;
+            for (std::size_t k = 0; k < vs.size; ++k) {
+                const point_t& a = v[k];
+                const point_t& b = v[(k + 1) % vs.size];
+                const double ax = static_cast<double>(static_cast<T>(a[0]));
+                const double ay = static_cast<double>(static_cast<T>(a[1]));
+                const double bx = static_cast<double>(static_cast<T>(b[0]));
+                const double by = static_cast<double>(static_cast<T>(b[1]));
+                const double cross = ax * by - bx * ay;
+                area += cross;
+                cx += (ax + bx) * cross;
+                cy += (ay + by) * cross;
+            }
+            if (std::abs(area) < TOLERANCE) {
+                continue;
+            }
+
+            const double x = cx / (3 * area);
+            const double y = cy / (3 * area);
+            const double dx = x - static_cast<double>(static_cast<T>(sites[i][0]));
+            const double dy = y - static_cast<double>(static_cast<T>(sites[i][1]));
+            centroids_[i] = point_t{static_cast<T>(x), static_cast<T>(y)};
+            scratch.max_shift = std::max(scratch.max_shift, dx * dx + dy * dy);
         }
+    });
+
+    double max_shift = 0;
+    for (const Scratch& scratch : scratch_) {
+        max_shift = std::max(max_shift, scratch.max_shift);
     }
+
+    return max_shift;
 }
 
 template <typename T>
 const std::vector<typename Voronoi<T>::Cell>& Voronoi<T>::cells() const {
+    // A copied diagram carries views into the source's storage
+    if (cells_dirty_ || cells_base_ != cell_vertices_.data()) {
+        build_cells();
+    }
+
     return cells_;
 }
 
+template <typename T>
+typename Voronoi<T>::Cell Voronoi<T>::cell(std::size_t idx) const {
+    const Slice& vs = vertex_slices_[idx];
+    const Slice& ns = neighbor_slices_[idx];
+
+    return Cell{sites()[idx],
+                Range<point_t>{cell_vertices_.data() + vs.offset, vs.size},
+                Range<std::size_t>{cell_neighbors_.data() + ns.offset, ns.size},
+                bounded_[idx] != 0};
+}
+
 template <typename T>
 const std::vector<typename Voronoi<T>::edge_t>& Voronoi<T>::edges() const {
+    if (edges_dirty_) {
+        build_edges();
+    }
+
     return edges_;
 }
 
 template <typename T>
 const std::vector<typename Voronoi<T>::point_t>& Voronoi<T>::vertices() const {
+    if (edges_dirty_) {
+        build_edges();
+    }
+
     return vertices_;
 }
 
 template <typename T>
 std::size_t Voronoi<T>::cell_count() const {
-    return cells_.size();
+    return vertex_slices_.size();
 }
 
 template <typename T>
 std::size_t Voronoi<T>::locate(const point_t& p) const {
     // Find cell containing point (nearest site)
+    const auto& points = sites();
     auto min_dist_sq = std::numeric_limits<T>::max();
     std::size_t nearest = 0;
 
-    for (std::size_t i = 0; i < cells_.size(); ++i) {
-        auto dx = static_cast<T>(p[0]) - static_cast<T>(cells_[i].site[0]);
-        auto dy = static_cast<T>(p[1]) - static_cast<T>(cells_[i].site[1]);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        auto dx = static_cast<T>(p[0]) - static_cast<T>(points[i][0]);
+        auto dy = static_cast<T>(p[1]) - static_cast<T>(points[i][1]);
         auto dist_sq = dx * dx + dy * dy;
 
         if (dist_sq < min_dist_sq) {
@@ -242,7 +901,7 @@ std::size_t Voronoi<T>::locate(const point_t& p) const {
 
 template <typename T>
 const typename Voronoi<T>::Cell* Voronoi<T>::cell_for_site(const point_t& site) const {
-    for (const auto& cell : cells_) {
+    for (const auto& cell : cells()) {
         if (cell.site == site) {
             return &cell;
         }
@@ -256,11 +915,11 @@ std::vector<typename Voronoi<T>::point_t> Voronoi<T>::nearest_neighbors(
 
     std::vector<std::pair<T, point_t>> distances;
 
-    for (const auto& cell : cells_) {
-        auto dx = static_cast<T>(p[0]) - static_cast<T>(cell.site[0]);
-        auto dy = static_cast<T>(p[1]) - static_cast<T>(cell.site[1]);
+    for (const auto& site : sites()) {
+        auto dx = static_cast<T>(p[0]) - static_cast<T>(site[0]);
+        auto dy = static_cast<T>(p[1]) - static_cast<T>(site[1]);
         auto dist_sq = dx * dx + dy * dy;
-        distances.emplace_back(dist_sq, cell.site);
+        distances.emplace_back(dist_sq, site);
     }
 
     std::sort(distances.begin(), distances.end(),
@@ -274,38 +933,39 @@ std::vector<typename Voronoi<T>::point_t> Voronoi<T>::nearest_neighbors(
     return result;
 }
 
+/*
+================================================================================================================
+                                Clipping
+================================================================================================================
+*/
 template <typename T>
 void Voronoi<T>::clip_to_bounds(const BoundingBox<T, 2>& bounds) {
     bounds_ = bounds;
     is_clipped_ = true;
 
-    for (auto& cell : cells_) {
-        clip_cell(cell, bounds);
+    // Stored unbounded cells have lost their rays (and earlier clips their
+    // parts outside the old bounds), so the cells are rebuilt from the
+    // triangulation or the sweep, each closed and clipped as it is written.
+    // Infinite edges are replaced with clipped versions on the next rebuild.
+    if (from_sweep_) {
+        build_from_sweep();
     }
-
-    // Update edges - replace infinite edges with clipped versions
-    std::vector<edge_t> clipped_edges;
-    for (const auto& e : edges_) {
-        if (e.is_infinite) {
-            point_t end = clip_infinite_edge(e, bounds);
-            clipped_edges.emplace_back(e.p1_, end);
-        } else {
-            clipped_edges.push_back(e);
-        }
+    else {
+        build_from_delaunay();
     }
-    edges_ = std::move(clipped_edges);
 }
 
 template <typename T>
 void Voronoi<T>::clip_to_bounds(T margin) {
-    if (cells_.empty()) {
+    const auto& points = sites();
+    if (points.empty()) {
         return;
     }
 
     // Compute bounds from sites
     BoundingBox<T, 2> bounds;
-    for (const auto& cell : cells_) {
-        bounds.expand(cell.site);
+    for (const auto& site : points) {
+        bounds.expand(site);
     }
 
     // Add margin
@@ -325,6 +985,80 @@ void Voronoi<T>::clip_to_bounds(T margin) {
     clip_to_bounds(expanded_bounds);
 }
 
+template <typename T>
+BoundingBox<T, 2> Voronoi<T>::closing_box(const point_t& site, const std::vector<point_t>& polygon) const {
+    // Holds the bounds, the site and the finite vertices with room to spare,
+    // so every ray of the cell starts inside and leaves it exactly once
+    BoundingBox<T, 2> box = bounds_;
+    box.expand(site);
+    for (const auto& p : polygon) {
+        box.expand(p);
+    }
+
+    auto min_pt = box.min();
+    auto max_pt = box.max();
+    auto margin = std::max(static_cast<T>(max_pt[0]) - static_cast<T>(min_pt[0]),
+                           static_cast<T>(max_pt[1]) - static_cast<T>(min_pt[1])) / 4 + static_cast<T>(1);
+
+    BoundingBox<T, 2> closing;
+    closing.expand(point_t{static_cast<T>(min_pt[0]) - margin, static_cast<T>(min_pt[1]) - margin});
+    closing.expand(point_t{static_cast<T>(max_pt[0]) + margin, static_cast<T>(max_pt[1]) + margin});
+
+    return closing;
+}
+
+template <typename T>
+void Voronoi<T>::append_corners(std::vector<point_t>& polygon, const point_t& from, const point_t& to,
+                                const BoundingBox<T, 2>& box) const {
+    // Corners strictly after from and before to, walking the boundary CCW;
+    // positions are measured along the boundary from the lower-left corner
+    auto min_pt = box.min();
+    auto max_pt = box.max();
+    const double x0 = static_cast<double>(static_cast<T>(min_pt[0]));
+    const double y0 = static_cast<double>(static_cast<T>(min_pt[1]));
+    const double w = static_cast<double>(static_cast<T>(max_pt[0])) - x0;
+    const double h = static_cast<double>(static_cast<T>(max_pt[1])) - y0;
+    const double perimeter = 2 * (w + h);
+
+    auto position = [&](const point_t& p) {
+        const double x = static_cast<double>(static_cast<T>(p[0])) - x0;
+        const double y = static_cast<double>(static_cast<T>(p[1])) - y0;
+        const double bottom = std::abs(y);
+        const double right = std::abs(w - x);
+        const double top = std::abs(h - y);
+        const double left = std::abs(x);
+        const double nearest = std::min({bottom, right, top, left});
+        if (nearest == bottom) {
+            return x;
+        }
+        if (nearest == right) {
+            return w + y;
+        }
+        if (nearest == top) {
+            return w + h + (w - x);
+        }
+        return 2 * w + h + (h - y);
+    };
+
+    const double start = position(from);
+    double stop = position(to);
+    if (stop <= start) {
+        stop += perimeter;
+    }
+
+    const point_t corners[4] = {point_t{static_cast<T>(min_pt[0]), static_cast<T>(min_pt[1])},
+                                point_t{static_cast<T>(max_pt[0]), static_cast<T>(min_pt[1])},
+                                point_t{static_cast<T>(max_pt[0]), static_cast<T>(max_pt[1])},
+                                point_t{static_cast<T>(min_pt[0]), static_cast<T>(max_pt[1])}};
+    const double offsets[4] = {0, w, w + h, 2 * w + h};
+    for (std::size_t k = 0; k < 8; ++k) {
+        const double at = offsets[k % 4] + (k < 4 ? 0 : perimeter);
+        if (at > start && at < stop) {
+            polygon.push_back(corners[k % 4]);
+        }
+    }
+}
+
 template <typename T>
 typename Voronoi<T>::point_t Voronoi<T>::clip_infinite_edge(
     const edge_t& e, const BoundingBox<T, 2>& bounds) const {
@@ -373,21 +1107,21 @@ typename Voronoi<T>::point_t Voronoi<T>::clip_infinite_edge(
 }
 
 template <typename T>
-void Voronoi<T>::clip_cell(Cell& cell, const BoundingBox<T, 2>& bounds) {
-    if (cell.vertices.empty()) {
+void Voronoi<T>::clip_polygon(std::vector<point_t>& polygon, std::vector<point_t>& buffer,
+                              const BoundingBox<T, 2>& bounds) const {
+    if (polygon.empty()) {
         return;
     }
 
-    // Sutherland-Hodgman clipping algorithm
+    // Sutherland-Hodgman, ping-ponging between the two buffers
     auto min_pt = bounds.min();
     auto max_pt = bounds.max();
 
-    auto clip_polygon_to_edge = [](std::vector<point_t>& polygon,
-                                   const point_t& edge_start,
-                                   const point_t& edge_end) {
-        if (polygon.empty()) return;
+    auto clip_polygon_to_edge = [](const std::vector<point_t>& input, std::vector<point_t>& output,
+                                   const point_t& edge_start, const point_t& edge_end) {
+        output.clear();
+        if (input.empty()) return;
 
-        std::vector<point_t> output;
         auto ex = static_cast<T>(edge_end[0]) - static_cast<T>(edge_start[0]);
         auto ey = static_cast<T>(edge_end[1]) - static_cast<T>(edge_start[1]);
 
@@ -412,9 +1146,9 @@ void Voronoi<T>::clip_cell(Cell& cell, const BoundingBox<T, 2>& bounds) {
             return point_t{x1 + t * (x2 - x1), y1 + t * (y2 - y1)};
         };
 
-        for (std::size_t i = 0; i < polygon.size(); ++i) {
-            const point_t& current = polygon[i];
-            const point_t& next = polygon[(i + 1) % polygon.size()];
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            const point_t& current = input[i];
+            const point_t& next = input[(i + 1) % input.size()];
 
             if (inside(current)) {
                 if (inside(next)) {
@@ -427,8 +1161,6 @@ void Voronoi<T>::clip_cell(Cell& cell, const BoundingBox<T, 2>& bounds) {
                 output.push_back(next);
             }
         }
-
-        polygon = std::move(output);
     };
 
     // Clip against all four edges
@@ -437,21 +1169,39 @@ void Voronoi<T>::clip_cell(Cell& cell, const BoundingBox<T, 2>& bounds) {
     point_t tr{static_cast<T>(max_pt[0]), static_cast<T>(max_pt[1])};
     point_t tl{static_cast<T>(min_pt[0]), static_cast<T>(max_pt[1])};
 
-    clip_polygon_to_edge(cell.vertices, bl, br);  // Bottom
-    clip_polygon_to_edge(cell.vertices, br, tr);  // Right
-    clip_polygon_to_edge(cell.vertices, tr, tl);  // Top
-    clip_polygon_to_edge(cell.vertices, tl, bl);  // Left
+    clip_polygon_to_edge(polygon, buffer, bl, br);  // Bottom
+    clip_polygon_to_edge(buffer, polygon, br, tr);  // Right
+    clip_polygon_to_edge(polygon, buffer, tr, tl);  // Top
+    clip_polygon_to_edge(buffer, polygon, tl, bl);  // Left
+
+    // A vertex on the box (or a box corner on a cell edge) comes out twice;
+    // drop the zero-length edges
+    auto coincide = [](const point_t& a, const point_t& b) {
+        return std::abs(static_cast<double>(static_cast<T>(a[0]) - static_cast<T>(b[0]))) <= TOLERANCE
+            && std::abs(static_cast<double>(static_cast<T>(a[1]) - static_cast<T>(b[1]))) <= TOLERANCE;
+    };
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        if (kept == 0 || !coincide(polygon[kept - 1], polygon[i])) {
+            polygon[kept++] = polygon[i];
+        }
+    }
+    while (kept > 1 && coincide(polygon[kept - 1], polygon[0])) {
+        --kept;
+    }
+    polygon.resize(kept);
 }
 
 template <typename T>
 std::vector<Polygon<T, 2>> Voronoi<T>::cell_polygons() const {
     std::vector<Polygon<T, 2>> result;
 
-    for (const auto& cell : cells_) {
-        if (cell.is_bounded || is_clipped_) {
+    for (std::size_t i = 0; i < vertex_slices_.size(); ++i) {
+        if (bounded_[i] || is_clipped_) {
+            const Slice& vs = vertex_slices_[i];
             Polygon<T, 2> poly;
-            for (const auto& v : cell.vertices) {
-                poly.push_back(v);
+            for (std::size_t k = 0; k < vs.size; ++k) {
+                poly.push_back(cell_vertices_[vs.offset + k]);
             }
             result.push_back(std::move(poly));
         }
@@ -462,16 +1212,28 @@ std::vector<Polygon<T, 2>> Voronoi<T>::cell_polygons() const {
 
 template <typename T>
 const Delaunay<T>& Voronoi<T>::delaunay() const {
-    return delaunay_;
+    return mesh();
 }
 
 template <typename T>
 void Voronoi<T>::clear() {
     delaunay_.clear();
+    sites_.clear();
+    mesh_pending_ = false;
+    sweep_.clear();
+    from_sweep_ = false;
+    cell_vertices_.clear();
+    cell_neighbors_.clear();
+    vertex_slices_.clear();
+    neighbor_slices_.clear();
+    bounded_.clear();
+    dead_vertices_ = 0;
+    dead_neighbors_ = 0;
     cells_.clear();
+    cells_dirty_ = true;
     edges_.clear();
     vertices_.clear();
-    site_to_cell_.clear();
+    edges_dirty_ = true;
     is_clipped_ = false;
 }
 
@@ -0,0 +1,321 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+// Self-contained benchmark harness for the geometry kernels: input
+// generators, an adaptive timing loop and console / JSON reporting. The JSON
+// layout follows Google Benchmark's (context + benchmarks array) so the usual
+// compare tools can diff two runs.
+
+#include "../core/include/Point.hpp"
+#include "../primitives/include/Polygon.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef COMPGEOM_REVISION
+#define COMPGEOM_REVISION "unknown"
+#endif
+
+#ifndef COMPGEOM_BUILD_TYPE
+#define COMPGEOM_BUILD_TYPE "unknown"
+#endif
+
+namespace bench {
+
+    using point_t = Point<double, 2>;
+    using polygon_t = Polygon<double, 2>;
+
+    constexpr double EXTENT = 1000.0;   // Inputs live in [0, EXTENT]^2
+
+    struct Options {
+        std::size_t min_size = 1000;
+        std::size_t max_size = 100000;  // 1e7 with --max-size 10000000
+        double min_time = 0.5;          // Seconds per benchmark
+        std::string filter;             // Substring of the benchmark name
+        std::string json;               // Output file, "-" for stdout
+    };
+
+    enum class Distribution { Uniform, Clustered, Degenerate };
+
+    inline const char* to_string(Distribution distribution) {
+        switch (distribution) {
+            case Distribution::Uniform: return "uniform";
+            case Distribution::Clustered: return "clustered";
+            default: return "degenerate";
+        }
+    }
+
+    constexpr Distribution DISTRIBUTIONS[] = {Distribution::Uniform, Distribution::Clustered, Distribution::Degenerate};
+
+    struct Result {
+        std::string kernel;
+        std::string distribution;
+        std::size_t size = 0;
+        std::size_t iterations = 0;
+        double real_time = 0;           // Milliseconds per iteration
+        double items_per_second = 0;
+    };
+
+/*
+================================================================================================================
+                                Options
+================================================================================================================
+*/
+    inline void print_usage(const char* program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --min-size N    smallest input (default 1000)\n"
+                  << "  --max-size N    largest input (default 100000, up to 10000000)\n"
+                  << "  --min-time S    seconds spent on each benchmark (default 0.5)\n"
+                  << "  --filter TEXT   only run benchmarks whose name contains TEXT\n"
+                  << "  --json FILE     write results as JSON (\"-\" for stdout)\n";
+    }
+
+    inline bool parse_options(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+                print_usage(argv[0]);
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--min-size") {
+                options.min_size = std::strtoull(value.c_str(), nullptr, 10);
+            }
+            else if (arg == "--max-size") {
+                options.max_size = std::strtoull(value.c_str(), nullptr, 10);
+            }
+            else if (arg == "--min-time") {
+                options.min_time = std::strtod(value.c_str(), nullptr);
+            }
+            else if (arg == "--filter") {
+                options.filter = value;
+            }
+            else if (arg == "--json") {
+                options.json = value;
+            }
+            else {
+                print_usage(argv[0]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+/*
+================================================================================================================
+                                Inputs
+================================================================================================================
+*/
+    // Uniform: the unit square scaled to EXTENT. Clustered: Gaussian blobs
+    // around sqrt(n) / 4 random centres. Degenerate: an integer lattice (rows
+    // of collinear and rings of cocircular points) with every tenth point
+    // repeated.
+    inline std::vector<point_t> make_points(Distribution distribution, std::size_t n, std::uint64_t seed = 42) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> coord(0.0, EXTENT);
+        std::vector<point_t> points;
+        points.reserve(n);
+
+        if (distribution == Distribution::Uniform) {
+            for (std::size_t i = 0; i < n; ++i) {
+                points.push_back(point_t{coord(rng), coord(rng)});
+            }
+        }
+        else if (distribution == Distribution::Clustered) {
+            const std::size_t clusters = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(n))) / 4);
+            std::vector<point_t> centres;
+            for (std::size_t c = 0; c < clusters; ++c) {
+                centres.push_back(point_t{coord(rng), coord(rng)});
+            }
+
+            std::normal_distribution<double> spread(0.0, EXTENT / (8.0 * std::sqrt(static_cast<double>(clusters))));
+            std::uniform_int_distribution<std::size_t> pick(0, clusters - 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                const point_t& c = centres[pick(rng)];
+                points.push_back(point_t{static_cast<double>(c[0]) + spread(rng), static_cast<double>(c[1]) + spread(rng)});
+            }
+        }
+        else {
+            const std::size_t side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+            const double step = EXTENT / static_cast<double>(side);
+            for (std::size_t i = 0; points.size() < n; ++i) {
+                if (i % 10 == 9 && !points.empty()) {
+                    points.push_back(points.back());
+                    continue;
+                }
+
+                const std::size_t cell = points.size();
+                points.push_back(point_t{static_cast<double>(cell % side) * step, static_cast<double>(cell / side) * step});
+            }
+        }
+
+        return points;
+    }
+
+    // Simple polygons with n vertices. Uniform: star-shaped around the centre
+    // with random radii. Clustered: the same with radii alternating between
+    // the rim and near the centre (long spikes). Degenerate: an axis-aligned
+    // square whose sides are runs of collinear vertices.
+    inline polygon_t make_polygon(Distribution distribution, std::size_t n, std::uint64_t seed = 42) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        polygon_t polygon;
+        const double c = EXTENT / 2;
+
+        if (distribution == Distribution::Degenerate) {
+            const std::size_t per_side = std::max<std::size_t>(1, n / 4);
+            const double corners[5][2] = {{0, 0}, {EXTENT, 0}, {EXTENT, EXTENT}, {0, EXTENT}, {0, 0}};
+            for (std::size_t side = 0; side < 4; ++side) {
+                for (std::size_t i = 0; i < per_side; ++i) {
+                    const double t = static_cast<double>(i) / static_cast<double>(per_side);
+                    polygon.push_back(point_t{corners[side][0] + t * (corners[side + 1][0] - corners[side][0]),
+                                              corners[side][1] + t * (corners[side + 1][1] - corners[side][1])});
+                }
+            }
+
+            return polygon;
+        }
+
+        const double pi = std::acos(-1.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double angle = 2 * pi * static_cast<double>(i) / static_cast<double>(n);
+            double radius = c * (0.5 + 0.5 * unit(rng));
+            if (distribution == Distribution::Clustered && i % 2 == 1) {
+                radius = c * 0.05 * (0.5 + unit(rng));
+            }
+            polygon.push_back(point_t{c + radius * std::cos(angle), c + radius * std::sin(angle)});
+        }
+
+        return polygon;
+    }
+
+    // Keeps results alive so the optimiser cannot drop the measured work
+    inline void consume(std::size_t value) {
+        static volatile std::size_t sink = 0;
+        sink = sink ^ value;
+    }
+
+/*
+================================================================================================================
+                                Suite
+================================================================================================================
+*/
+    class Suite {
+    public:
+        explicit Suite(const Options& options) : options_(options) {}
+
+        // Input sizes 1e3, 1e4, ... within [min_size, min(max_size, cap)]
+        std::vector<std::size_t> sizes(std::size_t cap) const {
+            std::vector<std::size_t> result;
+            for (std::size_t n = 1000; n <= std::min(options_.max_size, cap); n *= 10) {
+                if (n >= options_.min_size) {
+                    result.push_back(n);
+                }
+            }
+
+            return result;
+        }
+
+        bool enabled(const std::string& kernel) const {
+            return options_.filter.empty() || kernel.find(options_.filter) != std::string::npos;
+        }
+
+        // Repeats body() until min_time has passed (at least once); `items`
+        // is the work done per call, for the throughput column
+        template <typename Body>
+        void run(const std::string& kernel, Distribution distribution, std::size_t size,
+                 std::size_t items, Body&& body) {
+            using clock = std::chrono::steady_clock;
+            std::size_t iterations = 0;
+            double elapsed = 0;
+            while (iterations == 0 || elapsed < options_.min_time) {
+                const auto start = clock::now();
+                body();
+                elapsed += std::chrono::duration<double>(clock::now() - start).count();
+                ++iterations;
+            }
+
+            Result result;
+            result.kernel = kernel;
+            result.distribution = to_string(distribution);
+            result.size = size;
+            result.iterations = iterations;
+            result.real_time = elapsed * 1000 / static_cast<double>(iterations);
+            result.items_per_second = static_cast<double>(items) * static_cast<double>(iterations) / elapsed;
+            results_.push_back(result);
+
+            std::ostream& log = options_.json == "-" ? std::cerr : std::cout;
+            log << std::left << std::setw(52) << kernel + "/" + result.distribution + "/" + std::to_string(size)
+                << std::right << std::setw(14) << std::fixed << std::setprecision(3) << result.real_time << " ms"
+                << std::setw(10) << iterations << " it"
+                << std::setw(16) << std::setprecision(0) << result.items_per_second << " items/s\n";
+        }
+
+        const std::vector<Result>& results() const { return results_; }
+
+        bool write_json() const {
+            if (options_.json.empty()) {
+                return true;
+            }
+
+            std::ostringstream out;
+            const std::time_t now = std::time(nullptr);
+            char date[32];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << date << "\",\n"
+                << "    \"library\": \"CompGeom\",\n"
+                << "    \"revision\": \"" << COMPGEOM_REVISION << "\",\n"
+                << "    \"library_build_type\": \"" << COMPGEOM_BUILD_TYPE << "\",\n"
+                << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+                << "    \"min_time\": " << options_.min_time << "\n"
+                << "  },\n  \"benchmarks\": [";
+            out << std::setprecision(17);
+            for (std::size_t i = 0; i < results_.size(); ++i) {
+                const Result& r = results_[i];
+                out << (i == 0 ? "\n" : ",\n")
+                    << "    {\"name\": \"" << r.kernel << "/" << r.distribution << "/" << r.size << "\", "
+                    << "\"kernel\": \"" << r.kernel << "\", "
+                    << "\"distribution\": \"" << r.distribution << "\", "
+                    << "\"size\": " << r.size << ", "
+                    << "\"run_type\": \"iteration\", "
+                    << "\"iterations\": " << r.iterations << ", "
+                    << "\"real_time\": " << r.real_time << ", "
+                    << "\"time_unit\": \"ms\", "
+                    << "\"items_per_second\": " << r.items_per_second << "}";
+            }
+            out << "\n  ]\n}\n";
+
+            if (options_.json == "-") {
+                std::cout << out.str();
+                return true;
+            }
+
+            std::ofstream file(options_.json);
+            file << out.str();
+
+            return static_cast<bool>(file);
+        }
+
+    private:
+        Options options_;
+        std::vector<Result> results_;
+    };
+
+} // namespace bench
+
+#endif // BENCH_HPP
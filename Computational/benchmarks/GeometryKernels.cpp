@@ -0,0 +1,265 @@
+// Geometry kernel benchmarks: triangulation, Voronoi, segment tree, polygon
+// predicates and every algo::intersect overload, on uniform, clustered and
+// degenerate inputs from 1e3 up to --max-size points.
+// Usage: GeometryKernels [--max-size N] [--filter TEXT] [--json FILE]
+#include "Bench.hpp"
+#include "../algorithms/include/Algorithms.hpp"
+#include "../algorithms/include/Delaunay.hpp"
+#include "../algorithms/include/Voronoi.hpp"
+#include "../algorithms/include/SegmentTree.hpp"
+#include "../primitives/include/Segment.hpp"
+#include "../primitives/include/Line.hpp"
+#include "../primitives/include/Ray.hpp"
+#include "../primitives/include/BoundingBox.hpp"
+
+using bench::Distribution;
+using bench::point_t;
+using bench::polygon_t;
+using segment_t = Segment<double, 2>;
+using ray_t = Ray<double, 2>;
+using line_t = Line<double, 2>;
+using box_t = BoundingBox<double, 2>;
+
+// Largest inputs per kernel; above these a single run takes minutes or the
+// input alone needs gigabytes
+constexpr std::size_t ALL_SIZES = 10000000;
+constexpr std::size_t POINTER_TREE_SIZES = 1000000;    // SegmentTree allocates one node per element
+constexpr std::size_t QUADRATIC_SIZES = 10000;         // Polygon::isSimple tests every edge pair
+constexpr std::size_t LINEAR_QUERY_SIZES = 1000000;    // Polygon scans per query
+constexpr std::size_t PAIR_SIZES = 1000000;
+
+constexpr std::size_t TREE_OPERATIONS = 1 << 16;
+constexpr std::size_t POLYGON_QUERIES = 256;
+
+/*
+================================================================================================================
+                                Triangulation / Voronoi
+================================================================================================================
+*/
+void bench_meshes(bench::Suite& suite) {
+    for (std::size_t n : suite.sizes(ALL_SIZES)) {
+        for (Distribution distribution : bench::DISTRIBUTIONS) {
+            const std::vector<point_t> points = bench::make_points(distribution, n);
+            if (suite.enabled("Delaunay::triangulate")) {
+                Delaunay<double> delaunay;
+                suite.run("Delaunay::triangulate", distribution, n, n, [&] {
+                    delaunay.triangulate(points);
+                    bench::consume(delaunay.triangle_count());
+                });
+            }
+            if (suite.enabled("Voronoi::compute")) {
+                Voronoi<double> voronoi;
+                suite.run("Voronoi::compute", distribution, n, n, [&] {
+                    voronoi.compute(points);
+                    bench::consume(voronoi.cell_count());
+                });
+            }
+        }
+    }
+}
+
+/*
+================================================================================================================
+                                Segment Tree
+================================================================================================================
+*/
+void bench_segment_tree(bench::Suite& suite) {
+    for (std::size_t n : suite.sizes(POINTER_TREE_SIZES)) {
+        for (Distribution distribution : bench::DISTRIBUTIONS) {
+            // Values from the x coordinates; ranges between random indices
+            // (degenerate: single-element ranges and one repeated index)
+            const std::vector<point_t> points = bench::make_points(distribution, n);
+            std::vector<long long> values(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                values[i] = static_cast<long long>(static_cast<double>(points[i][0]));
+            }
+
+            std::mt19937_64 rng(7);
+            std::vector<std::pair<std::size_t, std::size_t>> ranges(TREE_OPERATIONS);
+            for (auto& range : ranges) {
+                std::size_t a = rng() % n, b = rng() % n;
+                if (distribution == Distribution::Degenerate) {
+                    b = a = (a % 2 == 0) ? n / 2 : a;
+                }
+                range = {std::min(a, b), std::max(a, b)};
+            }
+
+            SumSegmentTree<long long> tree(values);
+            if (suite.enabled("SegmentTree::build")) {
+                suite.run("SegmentTree::build", distribution, n, n, [&] {
+                    tree.build(values);
+                    bench::consume(tree.size());
+                });
+            }
+            if (suite.enabled("SegmentTree::query")) {
+                suite.run("SegmentTree::query", distribution, n, TREE_OPERATIONS, [&] {
+                    long long total = 0;
+                    for (const auto& range : ranges) {
+                        total += tree.query(range.first, range.second);
+                    }
+                    bench::consume(static_cast<std::size_t>(total));
+                });
+            }
+            if (suite.enabled("SegmentTree::update")) {
+                suite.run("SegmentTree::update", distribution, n, TREE_OPERATIONS, [&] {
+                    for (const auto& range : ranges) {
+                        tree.update(range.first, static_cast<long long>(range.second));
+                    }
+                });
+            }
+            if (suite.enabled("SegmentTree::range_update")) {
+                suite.run("SegmentTree::range_update", distribution, n, TREE_OPERATIONS, [&] {
+                    for (const auto& range : ranges) {
+                        tree.range_update(range.first, range.second, 1);
+                    }
+                });
+            }
+        }
+    }
+}
+
+/*
+================================================================================================================
+                                Polygon Predicates
+================================================================================================================
+*/
+void bench_polygons(bench::Suite& suite) {
+    for (std::size_t n : suite.sizes(LINEAR_QUERY_SIZES)) {
+        for (Distribution distribution : bench::DISTRIBUTIONS) {
+            const polygon_t polygon = bench::make_polygon(distribution, n);
+            if (suite.enabled("Polygon::contains")) {
+                const std::vector<point_t> queries = bench::make_points(distribution, POLYGON_QUERIES, 11);
+                suite.run("Polygon::contains", distribution, n, POLYGON_QUERIES, [&] {
+                    std::size_t inside = 0;
+                    for (const auto& q : queries) {
+                        inside += polygon.contains(q) ? 1 : 0;
+                    }
+                    bench::consume(inside);
+                });
+            }
+            if (n <= QUADRATIC_SIZES && suite.enabled("Polygon::isSimple")) {
+                suite.run("Polygon::isSimple", distribution, n, n, [&] {
+                    bench::consume(polygon.isSimple() ? 1 : 0);
+                });
+            }
+        }
+    }
+}
+
+/*
+================================================================================================================
+                                Intersection Tests
+================================================================================================================
+*/
+// Primitive pairs: n pairs per iteration, built from consecutive input
+// points (degenerate inputs give collinear and overlapping primitives)
+template <typename A, typename B>
+void bench_pairs(bench::Suite& suite, const std::string& kernel, Distribution distribution,
+                 const std::vector<A>& first, const std::vector<B>& second) {
+    if (!suite.enabled(kernel)) {
+        return;
+    }
+
+    suite.run(kernel, distribution, first.size(), first.size(), [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < first.size(); ++i) {
+            hits += algo::intersect(first[i], second[i]) ? 1 : 0;
+        }
+        bench::consume(hits);
+    });
+}
+
+// Polygon against a primitive: one test on an n-vertex polygon per iteration
+template <typename A, typename B>
+void bench_polygon_pair(bench::Suite& suite, const std::string& kernel, Distribution distribution,
+                        std::size_t n, const A& a, const B& b) {
+    if (!suite.enabled(kernel)) {
+        return;
+    }
+
+    suite.run(kernel, distribution, n, n, [&] {
+        bench::consume(algo::intersect(a, b) ? 1 : 0);
+    });
+}
+
+void bench_intersections(bench::Suite& suite) {
+    for (std::size_t n : suite.sizes(PAIR_SIZES)) {
+        for (Distribution distribution : bench::DISTRIBUTIONS) {
+            const std::vector<point_t> points = bench::make_points(distribution, 4 * n);
+            std::vector<segment_t> segments, other_segments;
+            std::vector<ray_t> rays, other_rays;
+            std::vector<line_t> lines, other_lines;
+            std::vector<box_t> boxes, other_boxes;
+            for (std::size_t i = 0; i < n; ++i) {
+                const point_t& a = points[4 * i];
+                const point_t& b = points[4 * i + 1];
+                const point_t& c = points[4 * i + 2];
+                const point_t& d = points[4 * i + 3];
+                segments.emplace_back(a, b);
+                other_segments.emplace_back(c, d);
+                rays.emplace_back(a, b);
+                other_rays.emplace_back(c, d);
+                lines.emplace_back(a, b);
+                other_lines.emplace_back(c, d);
+
+                box_t box, other_box;
+                box.expand(a);
+                box.expand(b);
+                other_box.expand(c);
+                other_box.expand(d);
+                boxes.push_back(box);
+                other_boxes.push_back(other_box);
+            }
+
+            bench_pairs(suite, "intersect(Segment,Segment)", distribution, segments, other_segments);
+            bench_pairs(suite, "intersect(Ray,Ray)", distribution, rays, other_rays);
+            bench_pairs(suite, "intersect(Line,Line)", distribution, lines, other_lines);
+            bench_pairs(suite, "intersect(Line,Segment)", distribution, lines, other_segments);
+            bench_pairs(suite, "intersect(Segment,Line)", distribution, segments, other_lines);
+            bench_pairs(suite, "intersect(Ray,Line)", distribution, rays, other_lines);
+            bench_pairs(suite, "intersect(Line,Ray)", distribution, lines, other_rays);
+            bench_pairs(suite, "intersect(Segment,Ray)", distribution, segments, other_rays);
+            bench_pairs(suite, "intersect(Ray,Segment)", distribution, rays, other_segments);
+            bench_pairs(suite, "intersect(BoundingBox,BoundingBox)", distribution, boxes, other_boxes);
+
+            // Polygon overloads: the probes cross the polygon's middle, so
+            // the tests that stop at the first hit still see half the edges
+            const polygon_t polygon = bench::make_polygon(distribution, n);
+            const polygon_t other = bench::make_polygon(distribution, n, 43);
+            const double mid = bench::EXTENT / 2;
+            const point_t from{mid, mid};
+            const point_t to{2 * bench::EXTENT, mid + 1};
+            const segment_t segment(from, to);
+            const ray_t ray(from, to);
+            const line_t line(from, to);
+
+            bench_polygon_pair(suite, "intersect(Polygon,Polygon)", distribution, n, polygon, other);
+            bench_polygon_pair(suite, "intersect(Polygon,Segment)", distribution, n, polygon, segment);
+            bench_polygon_pair(suite, "intersect(Segment,Polygon)", distribution, n, segment, polygon);
+            bench_polygon_pair(suite, "intersect(Polygon,Ray)", distribution, n, polygon, ray);
+            bench_polygon_pair(suite, "intersect(Ray,Polygon)", distribution, n, ray, polygon);
+            bench_polygon_pair(suite, "intersect(Polygon,Line)", distribution, n, polygon, line);
+            bench_polygon_pair(suite, "intersect(Line,Polygon)", distribution, n, line, polygon);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    if (!bench::parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    bench::Suite suite(options);
+    bench_meshes(suite);
+    bench_segment_tree(suite);
+    bench_polygons(suite);
+    bench_intersections(suite);
+
+    if (!suite.write_json()) {
+        std::cerr << "Could not write " << options.json << "\n";
+        return 1;
+    }
+
+    return 0;
+}
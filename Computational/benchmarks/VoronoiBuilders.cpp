@@ -0,0 +1,52 @@
+// Compares the two Voronoi construction paths on uniformly random sites:
+// the Delaunay dual and Fortune's sweep. Usage: VoronoiBuilders [sites] [runs]
+#include "../algorithms/include/Voronoi.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using point_t = Point<double, 2>;
+using voronoi_t = Voronoi<double>;
+
+double time_build(const std::vector<point_t>& sites, voronoi_t::Method method, std::size_t runs, std::size_t& edges) {
+    double best = 0;
+    for (std::size_t run = 0; run < runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        voronoi_t diagram;
+        diagram.compute(sites, method);
+        edges = diagram.edges().size();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (run == 0 || ms < best) {
+            best = ms;
+        }
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::size_t runs = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::vector<point_t> sites;
+    sites.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sites.push_back(point_t{coord(rng), coord(rng)});
+    }
+
+    std::size_t dual_edges = 0;
+    std::size_t sweep_edges = 0;
+    const double dual = time_build(sites, voronoi_t::Method::DelaunayDual, runs, dual_edges);
+    const double sweep = time_build(sites, voronoi_t::Method::FortuneSweep, runs, sweep_edges);
+
+    std::cout << "sites:          " << count << "\n"
+              << "delaunay dual:  " << dual << " ms (" << dual_edges << " edges)\n"
+              << "fortune sweep:  " << sweep << " ms (" << sweep_edges << " edges)\n"
+              << "speedup:        " << dual / sweep << "x\n";
+
+    return 0;
+}
@@ -16,7 +16,6 @@ struct coord_t {
 
     operator const T&() const;
     operator T&();
-    operator double() const;
 
     
     coord_t operator+(const coord_t& other) const;
@@ -16,9 +16,6 @@ coord_t<T>::operator const T&() const { return value; }
 template <typename T>
 coord_t<T>::operator T&() { return value; }
 
-template <typename T>
-coord_t<T>::operator double() const { return static_cast<double>(value); }
-
 template <typename T>
 coord_t<T> coord_t<T>::operator+(const coord_t& other) const {
     return coord_t(value + other.value);
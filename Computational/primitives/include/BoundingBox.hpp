@@ -14,8 +14,8 @@ class BoundingBox {
     static_assert(N > 0, "Dimension must be > 0");
 
 public:
-    using Point   = Point<T, N>;
-    using coord_t = coord_t<T>;
+    using Point   = ::Point<T, N>;
+    using coord_t = ::coord_t<T>;
 
     BoundingBox();
     BoundingBox(const BoundingBox& other);
@@ -16,9 +16,9 @@ class Polygon {
     static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
 
 public:
-    using Point = Point<T, N>;
-    using coord_t = coord_t<T>;
-    using Segment = Segment<T, N>;
+    using Point = ::Point<T, N>;
+    using coord_t = ::coord_t<T>;
+    using Segment = ::Segment<T, N>;
 
     Polygon() = default;
     Polygon(const Polygon& other);
@@ -54,11 +54,11 @@ void BoundingBox<T, N>::expand(const BoundingBox& other) {
 
 template <typename T, std::size_t N>
 void BoundingBox<T, N>::reset() {
-    constexpr coord_t inf = std::numeric_limits<T>::has_infinity
+    const coord_t inf = std::numeric_limits<T>::has_infinity
         ? std::numeric_limits<T>::infinity()
         : std::numeric_limits<T>::max();
 
-    constexpr coord_t ninf = std::numeric_limits<T>::has_infinity
+    const coord_t ninf = std::numeric_limits<T>::has_infinity
         ? -std::numeric_limits<T>::infinity()
         : std::numeric_limits<T>::lowest();
 
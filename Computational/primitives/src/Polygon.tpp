@@ -4,6 +4,12 @@
 #include <algorithm>
 #include "../include/Polygon.hpp"
 
+// Used by isSimple(); defined by Algorithms.hpp, included at the end
+namespace algo {
+    template <typename T, std::size_t N>
+    bool intersect(const Segment<T, N>& seg1, const Segment<T, N>& seg2) noexcept;
+}
+
 template <typename T, std::size_t N>
 Polygon<T, N>::Polygon(const Polygon& other)
     : data_(other.data_), box_(other.box_), boxDirty_(other.boxDirty_) {}
@@ -131,13 +137,13 @@ bool Polygon<T, N>::contains(const Point& p) const {
 
     bool inside = false;
     coord_t px = p[0], py = p[1];
-    const coord_t eps = coord_t<T>::TOLERANCE;
+    const coord_t eps = ::coord_t<T>::TOLERANCE;
     for (std::size_t i = 0, j = data_.size() - 1; i < data_.size(); j = i++) {
         coord_t ax = data_[i][0], ay = data_[i][1];
         coord_t bx = data_[j][0], by = data_[j][1];
         if ((ay > py) != (by > py)) {
             coord_t denom = by - ay;
-            if ((denom >= coord_t{0} ? denom : -denom) < eps) {
+            if ((denom >= coord_t{0} ? denom : coord_t{-denom.value}) < eps) {
                 continue;
             }
             
@@ -166,7 +172,7 @@ auto Polygon<T, N>::area() const { // ?
         sum += a[0] * b[1] - b[0] * a[1];
     }
     
-    return (sum >= coord_t{0} ? sum : -sum) * coord_t{0.5};
+    return (sum >= coord_t{0} ? sum : coord_t{-sum.value}) * coord_t{0.5};
 }
 
 template <typename T, std::size_t N>
@@ -227,7 +233,7 @@ bool Polygon<T, N>::isSimple() const { // no self intersection
             }
             
             Segment s2(data_[j], data_[(j + 1) % n]);
-            if (s1.intersects(s2)) {
+            if (algo::intersect(s1, s2)) {
                 return false;
             }
         }
@@ -270,4 +276,6 @@ void Polygon<T, N>::insert(std::size_t index, const Point& p) {
     boxDirty_ = true;
 }
 
+#include "../../algorithms/include/Algorithms.hpp"
+
 #endif // POLYGON_TPP
\ No newline at end of file
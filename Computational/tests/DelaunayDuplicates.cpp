@@ -0,0 +1,131 @@
+// Delaunay updates on inputs with coincident points: every remove() and
+// move() must leave an empty-circumcircle triangulation in which each point
+// of points() is a mesh vertex. Exits non-zero on the first failure.
+#include "../algorithms/include/Delaunay.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using delaunay_t = Delaunay<double>;
+using point_t = delaunay_t::point_t;
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool condition, const char* what, int step) {
+        if (!condition) {
+            std::printf("FAIL step %d: %s\n", step, what);
+            ++failures;
+        }
+    }
+
+    // Brute force, independent of the mesh's own is_valid(): no point lies
+    // strictly inside the circumcircle of any triangle
+    bool empty_circles(const delaunay_t& mesh) {
+        const auto& points = mesh.points();
+        for (const auto& tri : mesh.triangle_indices()) {
+            const point_t& a = points[tri[0]];
+            const point_t& b = points[tri[1]];
+            const point_t& c = points[tri[2]];
+            for (const point_t& d : points) {
+                const double ax = a[0] - d[0], ay = a[1] - d[1];
+                const double bx = b[0] - d[0], by = b[1] - d[1];
+                const double cx = c[0] - d[0], cy = c[1] - d[1];
+                const double det = (ax * ax + ay * ay) * (bx * cy - cx * by)
+                                 - (bx * bx + by * by) * (ax * cy - cx * ay)
+                                 + (cx * cx + cy * cy) * (ax * by - bx * ay);
+                if (det > 1e-9) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Every point, duplicates included, is represented in the mesh
+    bool no_orphans(const delaunay_t& mesh) {
+        for (const point_t& p : mesh.points()) {
+            if (mesh.find(p) == delaunay_t::npos) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void check(const delaunay_t& mesh, int step) {
+        expect(mesh.is_valid(), "is_valid", step);
+        expect(empty_circles(mesh), "empty circumcircles", step);
+        expect(no_orphans(mesh), "every point in the mesh", step);
+    }
+
+    // Points on a coarse grid, so many of them repeat
+    std::vector<point_t> repeated_points(std::mt19937& rng, std::size_t n) {
+        std::uniform_int_distribution<int> coordinate(0, 7);
+        std::vector<point_t> points;
+        for (std::size_t i = 0; i < n; ++i) {
+            points.push_back(point_t{coordinate(rng) * 1.5 + 0.25 * coordinate(rng), coordinate(rng) * 1.25});
+        }
+
+        return points;
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(2024);
+    int step = 0;
+
+    // Removing a position held several times keeps the others in the mesh
+    {
+        delaunay_t mesh(repeated_points(rng, 120));
+        check(mesh, step++);
+        while (mesh.point_count() > 3) {
+            const point_t p = mesh.points()[rng() % mesh.point_count()];
+            const std::size_t before = mesh.point_count();
+            if (!mesh.remove(p)) {
+                expect(false, "remove returns true", step);
+                break;
+            }
+            expect(mesh.point_count() == before - 1, "remove drops one point", step);
+            check(mesh, step++);
+        }
+    }
+
+    // Moves of mesh vertices and duplicates, onto free and occupied positions
+    {
+        delaunay_t mesh(repeated_points(rng, 120));
+        std::uniform_real_distribution<double> offset(-1.0, 1.0);
+        for (int i = 0; i < 400; ++i) {
+            const std::size_t point = rng() % mesh.point_count();
+            const point_t to = rng() % 2 ? mesh.points()[rng() % mesh.point_count()]
+                                         : point_t{mesh.points()[point][0] + offset(rng), mesh.points()[point][1] + offset(rng)};
+            expect(mesh.move(point, to), "move returns true", step);
+            expect(mesh.points()[point] == to, "moved point is at its target", step);
+            check(mesh, step++);
+        }
+    }
+
+    // A point merged by a move can be moved out again
+    {
+        delaunay_t mesh(std::vector<point_t>{{0, 0}, {4, 0}, {0, 4}, {4, 4}, {2, 1}});
+        expect(mesh.move(4, point_t{4, 4}), "move onto an occupied position", step);
+        check(mesh, step++);
+        expect(mesh.move(4, point_t{2, 3}), "move a merged point away", step);
+        expect(mesh.find(point_t{2, 3}) == 4, "merged point back as its own vertex", step);
+        check(mesh, step++);
+        expect(mesh.remove(point_t{4, 4}), "remove the former host", step);
+        expect(mesh.find(point_t{4, 4}) == delaunay_t::npos, "position gone once removed", step);
+        check(mesh, step++);
+    }
+
+    if (failures != 0) {
+        std::printf("%d failure(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("DelaunayDuplicates: %d steps passed\n", step);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+// Bounded Voronoi cells and Lloyd relaxation against brute force: every cell
+// clipped to the box must match the box cut by the bisectors of all other
+// sites, and relax(bounds) must end with each site on the centroid of that
+// reference cell. Exits non-zero on the first failure.
+#include "../algorithms/include/Voronoi.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using voronoi_t = Voronoi<double>;
+using point_t = voronoi_t::point_t;
+using box_t = BoundingBox<double, 2>;
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool condition, const char* what, const char* label) {
+        if (!condition) {
+            std::printf("FAIL %s: %s\n", label, what);
+            ++failures;
+        }
+    }
+
+    // Keeps the part of polygon on the site's side of its bisector with other
+    void cut(std::vector<point_t>& polygon, const point_t& site, const point_t& other) {
+        const double sx = site[0], sy = site[1];
+        const double ox = other[0], oy = other[1];
+        const double nx = ox - sx;
+        const double ny = oy - sy;
+        const double offset = (ox * ox + oy * oy - sx * sx - sy * sy) / 2;
+        auto side = [&](const point_t& p) { return p[0] * nx + p[1] * ny - offset; };
+
+        std::vector<point_t> result;
+        for (std::size_t i = 0; i < polygon.size(); ++i) {
+            const point_t& a = polygon[i];
+            const point_t& b = polygon[(i + 1) % polygon.size()];
+            const double sa = side(a);
+            const double sb = side(b);
+            if (sa <= 0) {
+                result.push_back(a);
+            }
+            if ((sa < 0 && sb > 0) || (sa > 0 && sb < 0)) {
+                const double t = sa / (sa - sb);
+                result.push_back(point_t{a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1])});
+            }
+        }
+        polygon = std::move(result);
+    }
+
+    std::vector<point_t> reference_cell(const std::vector<point_t>& sites, std::size_t i, const box_t& box) {
+        std::vector<point_t> polygon{box.min(), point_t{box.max()[0], box.min()[1]}, box.max(), point_t{box.min()[0], box.max()[1]}};
+        for (std::size_t j = 0; j < sites.size() && !polygon.empty(); ++j) {
+            if (j != i) {
+                cut(polygon, sites[i], sites[j]);
+            }
+        }
+
+        return polygon;
+    }
+
+    template <typename Vertices>
+    double area(const Vertices& polygon, point_t* centroid = nullptr) {
+        double twice = 0, cx = 0, cy = 0;
+        for (std::size_t k = 0; k < polygon.size(); ++k) {
+            const point_t& a = polygon[k];
+            const point_t& b = polygon[(k + 1) % polygon.size()];
+            const double cross = a[0] * b[1] - b[0] * a[1];
+            twice += cross;
+            cx += (a[0] + b[0]) * cross;
+            cy += (a[1] + b[1]) * cross;
+        }
+        if (centroid && twice != 0) {
+            *centroid = point_t{cx / (3 * twice), cy / (3 * twice)};
+        }
+
+        return twice / 2;
+    }
+
+    // Clipped cells tile the box, each one as large as its reference cell,
+    // with no repeated vertices
+    void check_cells(const voronoi_t& voronoi, const box_t& box, const char* label) {
+        const auto& sites = voronoi.delaunay().points();
+        const double box_area = (box.max()[0] - box.min()[0]) * (box.max()[1] - box.min()[1]);
+        double total = 0;
+        bool areas_match = true;
+        bool distinct = true;
+        for (std::size_t i = 0; i < voronoi.cell_count(); ++i) {
+            const auto cell = voronoi.cell(i);
+            const double cell_area = area(cell.vertices);
+            total += cell_area;
+            areas_match = areas_match && std::abs(cell_area - area(reference_cell(sites, i, box))) < 1e-6 * box_area;
+            for (std::size_t k = 0; k < cell.vertices.size(); ++k) {
+                const point_t& a = cell.vertices[k];
+                const point_t& b = cell.vertices[(k + 1) % cell.vertices.size()];
+                distinct = distinct && (std::abs(a[0] - b[0]) > 1e-9 || std::abs(a[1] - b[1]) > 1e-9);
+            }
+        }
+        expect(std::abs(total - box_area) < 1e-6 * box_area, "cells tile the box", label);
+        expect(areas_match, "cell areas match brute force", label);
+        expect(distinct, "no zero-length cell edges", label);
+    }
+
+    void check_relax(std::vector<point_t> sites, const box_t& box, const char* label) {
+        voronoi_t voronoi;
+        voronoi.compute(sites, voronoi_t::Method::DelaunayDual);
+        const std::size_t iterations = voronoi.relax(box, 2000, 1e-7);
+        expect(iterations < 2000, "relax reaches the tolerance", label);
+        check_cells(voronoi, box, label);
+
+        const auto& relaxed = voronoi.delaunay().points();
+        double worst = 0;
+        for (std::size_t i = 0; i < relaxed.size(); ++i) {
+            point_t centroid = relaxed[i];
+            area(reference_cell(relaxed, i, box), &centroid);
+            worst = std::max(worst, std::hypot(centroid[0] - relaxed[i][0], centroid[1] - relaxed[i][1]));
+        }
+        expect(worst < 1e-5, "sites sit on their brute-force centroids", label);
+        std::printf("%s: %zu iterations, worst centroid offset %g\n", label, iterations, worst);
+    }
+
+} // namespace
+
+int main() {
+    box_t box;
+    box.expand(point_t{0, 0});
+    box.expand(point_t{10, 10});
+
+    // Corner cells used to collapse to the chord of their finite vertices
+    const std::vector<point_t> symmetric{{2, 2}, {8, 2}, {2, 8}, {8, 8}, {5, 5}};
+    for (auto method : {voronoi_t::Method::DelaunayDual, voronoi_t::Method::FortuneSweep}) {
+        voronoi_t voronoi;
+        voronoi.compute(symmetric, method);
+        voronoi.clip_to_bounds(box);
+        check_cells(voronoi, box, method == voronoi_t::Method::FortuneSweep ? "symmetric, sweep" : "symmetric, dual");
+    }
+    check_relax(symmetric, box, "symmetric relax");
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 10.0);
+    std::vector<point_t> random;
+    for (int i = 0; i < 60; ++i) {
+        random.push_back(point_t{coordinate(rng), coordinate(rng)});
+    }
+    for (auto method : {voronoi_t::Method::DelaunayDual, voronoi_t::Method::FortuneSweep}) {
+        voronoi_t voronoi;
+        voronoi.compute(random, method);
+        voronoi.clip_to_bounds(box);
+        check_cells(voronoi, box, method == voronoi_t::Method::FortuneSweep ? "random, sweep" : "random, dual");
+    }
+    check_relax(random, box, "random relax");
+
+    // Sites near the box edge, where a vertex lands on the boundary
+    std::vector<point_t> edge{{99.79, 98.06}};
+    for (int i = 0; i < 40; ++i) {
+        edge.push_back(point_t{coordinate(rng) * 10, coordinate(rng) * 10});
+    }
+    box_t large;
+    large.expand(point_t{0, 0});
+    large.expand(point_t{100, 100});
+    for (auto method : {voronoi_t::Method::DelaunayDual, voronoi_t::Method::FortuneSweep}) {
+        voronoi_t voronoi;
+        voronoi.compute(edge, method);
+        voronoi.clip_to_bounds(large);
+        check_cells(voronoi, large, method == voronoi_t::Method::FortuneSweep ? "near the edge, sweep" : "near the edge, dual");
+    }
+
+    if (failures != 0) {
+        std::printf("%d failure(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
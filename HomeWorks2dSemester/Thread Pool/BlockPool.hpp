@@ -0,0 +1,190 @@
+#ifndef BLOCK_POOL_HPP
+#define BLOCK_POOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// Size-class freelists for the pool's small, short-lived allocations (task
+// nodes, oversized closures, future shared states). Every thread keeps its
+// own cache per class and only touches the shared, mutex-protected list in
+// batches: when the cache runs dry, or when it grows past CACHE_LIMIT because
+// this thread frees blocks another thread allocated (workers finishing tasks
+// submitted from outside). Requests above MAX_BLOCK go to operator new.
+// Blocks are never handed back to the system.
+class block_pool {
+public:
+    static void* allocate(std::size_t bytes);
+    static void deallocate(void* ptr, std::size_t bytes);
+
+private:
+    static constexpr std::size_t MIN_BLOCK = 64;
+    static constexpr std::size_t MAX_BLOCK = 256;
+    static constexpr std::size_t CLASSES = 3;        // 64, 128, 256 bytes
+    static constexpr std::size_t BATCH = 64;         // Blocks moved per trip to the shared list
+    static constexpr std::size_t CACHE_LIMIT = 4 * BATCH;
+
+    struct block {
+        block* next;
+    };
+
+    struct shared_list {
+        std::mutex mutex;
+        block* head = nullptr;
+    };
+
+    struct local_cache {
+        block* head[CLASSES] = {};
+        std::size_t count[CLASSES] = {};
+
+        ~local_cache();
+    };
+
+    static std::size_t size_class(std::size_t bytes);
+    static std::size_t block_size(std::size_t cls);
+    static shared_list& shared(std::size_t cls);
+    static local_cache& local();
+    static void refill(local_cache& cache, std::size_t cls);
+    static void spill(local_cache& cache, std::size_t cls, std::size_t keep);
+};
+
+// Allocator over block_pool, for std::promise's allocator_arg constructor
+template <typename T>
+struct pool_allocator {
+    using value_type = T;
+
+    pool_allocator() noexcept = default;
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        return static_cast<T*>(block_pool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            ::operator delete(ptr, std::align_val_t(alignof(T)));
+            return;
+        }
+
+        block_pool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const pool_allocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const pool_allocator<U>&) const noexcept { return false; }
+};
+
+// Allocation
+inline void* block_pool::allocate(std::size_t bytes) {
+    if (bytes > MAX_BLOCK) {
+        return ::operator new(bytes);
+    }
+
+    const std::size_t cls = size_class(bytes);
+    local_cache& cache = local();
+    if (!cache.head[cls]) {
+        refill(cache, cls);
+        if (!cache.head[cls]) {
+            return ::operator new(block_size(cls));
+        }
+    }
+
+    block* b = cache.head[cls];
+    cache.head[cls] = b->next;
+    --cache.count[cls];
+
+    return b;
+}
+
+inline void block_pool::deallocate(void* ptr, std::size_t bytes) {
+    if (bytes > MAX_BLOCK) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const std::size_t cls = size_class(bytes);
+    local_cache& cache = local();
+    block* b = static_cast<block*>(ptr);
+    b->next = cache.head[cls];
+    cache.head[cls] = b;
+    if (++cache.count[cls] > CACHE_LIMIT) {
+        spill(cache, cls, CACHE_LIMIT - BATCH);
+    }
+}
+
+// Size classes
+inline std::size_t block_pool::size_class(std::size_t bytes) {
+    std::size_t cls = 0;
+    while (block_size(cls) < bytes) {
+        ++cls;
+    }
+
+    return cls;
+}
+
+inline std::size_t block_pool::block_size(std::size_t cls) {
+    return MIN_BLOCK << cls;
+}
+
+// Shared lists, never destroyed so late thread exits can still spill into them
+inline block_pool::shared_list& block_pool::shared(std::size_t cls) {
+    static shared_list* lists = new shared_list[CLASSES];
+
+    return lists[cls];
+}
+
+inline block_pool::local_cache& block_pool::local() {
+    thread_local local_cache cache;
+
+    return cache;
+}
+
+// Moves up to BATCH blocks from the shared list into the cache
+inline void block_pool::refill(local_cache& cache, std::size_t cls) {
+    shared_list& list = shared(cls);
+    std::unique_lock<std::mutex> lock(list.mutex);
+    for (std::size_t i = 0; i < BATCH && list.head; ++i) {
+        block* b = list.head;
+        list.head = b->next;
+        b->next = cache.head[cls];
+        cache.head[cls] = b;
+        ++cache.count[cls];
+    }
+}
+
+// Moves all but `keep` cached blocks to the shared list
+inline void block_pool::spill(local_cache& cache, std::size_t cls, std::size_t keep) {
+    if (cache.count[cls] <= keep) {
+        return;
+    }
+
+    block* first = cache.head[cls];
+    block* last = first;
+    for (std::size_t i = keep + 1; i < cache.count[cls]; ++i) {
+        last = last->next;
+    }
+    cache.head[cls] = last->next;
+    cache.count[cls] = keep;
+
+    shared_list& list = shared(cls);
+    std::unique_lock<std::mutex> lock(list.mutex);
+    last->next = list.head;
+    list.head = first;
+}
+
+// A finished thread gives its cache back
+inline block_pool::local_cache::~local_cache() {
+    for (std::size_t cls = 0; cls < CLASSES; ++cls) {
+        spill(*this, cls, 0);
+    }
+}
+
+#endif // BLOCK_POOL_HPP
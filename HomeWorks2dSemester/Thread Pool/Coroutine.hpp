@@ -0,0 +1,350 @@
+#ifndef COROUTINE_HPP
+#define COROUTINE_HPP
+
+// C++20 coroutines over thread_pool: co_task<T>, sync_wait(), timers and
+// file reads that do not hold a worker while they wait. Needs -std=c++20.
+// (co_task rather than task: Task.hpp's task is the pool's callable.)
+
+#include "Pool.hpp"
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename T = void>
+class co_task;
+
+namespace detail {
+
+    struct co_task_promise_base {
+        std::coroutine_handle<> continuation;   // Awaiting coroutine, resumed when this one ends
+        std::exception_ptr error;
+
+        // Hands the thread straight to the awaiting coroutine
+        struct final_awaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        final_awaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    template <typename T>
+    struct co_task_promise : co_task_promise_base {
+        std::optional<T> value;
+
+        co_task<T> get_return_object();
+
+        template <typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+    };
+
+    template <>
+    struct co_task_promise<void> : co_task_promise_base {
+        co_task<void> get_return_object();
+
+        void return_void() const noexcept {}
+    };
+
+    // Eager, self-destroying coroutine that drives sync_wait()
+    struct detached_coroutine {
+        struct promise_type {
+            detached_coroutine get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+
+} // namespace detail
+
+// Lazy coroutine: nothing runs until it is awaited (or passed to
+// sync_wait), and the awaiter resumes on whichever thread finishes it.
+template <typename T>
+class co_task {
+public:
+    using promise_type = detail::co_task_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    co_task() noexcept = default;
+    explicit co_task(handle_type handle) noexcept : handle_(handle) {}
+
+    co_task(co_task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    co_task& operator=(co_task&& other) noexcept;
+    co_task(const co_task&) = delete;
+    co_task& operator=(const co_task&) = delete;
+    ~co_task();
+
+    bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+    // T (nothing for void); rethrows the coroutine's exception
+    auto operator co_await() && noexcept;
+    auto operator co_await() & noexcept;
+
+private:
+    struct awaiter {
+        handle_type handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+
+        T await_resume() const {
+            if (handle.promise().error) {
+                std::rethrow_exception(handle.promise().error);
+            }
+
+            if constexpr (!std::is_void<T>::value) {
+                return std::move(*handle.promise().value);
+            }
+        }
+    };
+
+    handle_type handle_;
+};
+
+template <typename T>
+co_task<T> detail::co_task_promise<T>::get_return_object() {
+    return co_task<T>(std::coroutine_handle<co_task_promise<T>>::from_promise(*this));
+}
+
+inline co_task<void> detail::co_task_promise<void>::get_return_object() {
+    return co_task<void>(std::coroutine_handle<co_task_promise<void>>::from_promise(*this));
+}
+
+template <typename T>
+co_task<T>& co_task<T>::operator=(co_task&& other) noexcept {
+    if (this != &other) {
+        if (handle_) {
+            handle_.destroy();
+        }
+        handle_ = std::exchange(other.handle_, nullptr);
+    }
+
+    return *this;
+}
+
+// Destructor
+template <typename T>
+co_task<T>::~co_task() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+template <typename T>
+auto co_task<T>::operator co_await() && noexcept {
+    return awaiter{handle_};
+}
+
+template <typename T>
+auto co_task<T>::operator co_await() & noexcept {
+    return awaiter{handle_};
+}
+
+// Runs a co_task from ordinary code: starts it on the calling thread and
+// helps with the pool's work until it has finished
+template <typename T>
+T sync_wait(thread_pool& pool, co_task<T> work) {
+    std::atomic<bool> done(false);
+    std::exception_ptr error;
+    std::optional<typename std::conditional<std::is_void<T>::value, char, T>::type> result;
+
+    auto driver = [](co_task<T>& work, std::atomic<bool>& done, std::exception_ptr& error,
+                     auto& result) -> detail::detached_coroutine {
+        try {
+            if constexpr (std::is_void<T>::value) {
+                co_await work;
+            }
+            else {
+                result.emplace(co_await work);
+            }
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        done.store(true, std::memory_order_release);
+    };
+    driver(work, done, error, result);
+
+    detail::help_until(pool, [&done] { return done.load(std::memory_order_acquire); });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    if constexpr (!std::is_void<T>::value) {
+        return std::move(*result);
+    }
+}
+
+// Timers
+// One thread for the whole process sleeps until the earliest deadline and
+// hands expired coroutines back to their pool. Timers still pending when
+// the process exits are dropped.
+class timer_service {
+public:
+    static timer_service& instance();
+
+    void schedule(std::chrono::steady_clock::time_point deadline, thread_pool& pool, std::coroutine_handle<> handle);
+
+    ~timer_service();
+
+private:
+    struct entry {
+        std::chrono::steady_clock::time_point deadline;
+        thread_pool* pool;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const entry& other) const { return deadline > other.deadline; }
+    };
+
+    timer_service();
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> timers_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+inline timer_service& timer_service::instance() {
+    static timer_service service;
+
+    return service;
+}
+
+// Constructor
+inline timer_service::timer_service() : thread_([this] { run(); }) {}
+
+// Destructor
+inline timer_service::~timer_service() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    condition_.notify_one();
+    thread_.join();
+}
+
+inline void timer_service::schedule(std::chrono::steady_clock::time_point deadline, thread_pool& pool,
+                                    std::coroutine_handle<> handle) {
+    bool earliest;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        earliest = timers_.empty() || deadline < timers_.top().deadline;
+        timers_.push(entry{deadline, &pool, handle});
+    }
+
+    if (earliest) {
+        condition_.notify_one();
+    }
+}
+
+inline void timer_service::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        if (timers_.empty()) {
+            condition_.wait(lock);
+            continue;
+        }
+
+        const entry next = timers_.top();
+        if (std::chrono::steady_clock::now() < next.deadline) {
+            condition_.wait_until(lock, next.deadline);
+            continue;
+        }
+
+        timers_.pop();
+        lock.unlock();
+        next.pool->enqueue_detached([handle = next.handle] { handle.resume(); });
+        lock.lock();
+    }
+}
+
+// `co_await sleep_until(pool, t)` / `co_await sleep_for(pool, d)`: resumes
+// on the pool once the time has come, without a thread waiting for it
+struct sleep_awaiter {
+    thread_pool& pool;
+    std::chrono::steady_clock::time_point deadline;
+
+    bool await_ready() const { return deadline <= std::chrono::steady_clock::now(); }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        timer_service::instance().schedule(deadline, pool, handle);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+inline sleep_awaiter sleep_until(thread_pool& pool, std::chrono::steady_clock::time_point deadline) {
+    return sleep_awaiter{pool, deadline};
+}
+
+template <typename Rep, typename Period>
+sleep_awaiter sleep_for(thread_pool& pool, std::chrono::duration<Rep, Period> duration) {
+    return sleep_awaiter{pool, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration)};
+}
+
+// Files
+// Whole-file read on a pool worker; the awaiting coroutine continues there.
+// Throws std::runtime_error if the file cannot be opened.
+inline co_task<std::string> read_file(thread_pool& pool, std::string path) {
+    co_await pool.schedule();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    co_return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// The same, split into lines without their terminators (a trailing '\r'
+// is kept, as std::getline would)
+inline co_task<std::vector<std::string>> read_lines(thread_pool& pool, std::string path) {
+    const std::string content = co_await read_file(pool, std::move(path));
+
+    std::vector<std::string> lines;
+    std::size_t start = 0;
+    while (start < content.size()) {
+        std::size_t end = content.find('\n', start);
+        if (end == std::string::npos) {
+            end = content.size();
+        }
+        lines.emplace_back(content, start, end - start);
+        start = end + 1;
+    }
+
+    co_return lines;
+}
+
+#endif // COROUTINE_HPP
@@ -0,0 +1,163 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's
+// ring). Every cell carries a sequence number saying whose turn it is:
+// a producer claims position p by CAS on the enqueue counter once the cell's
+// sequence equals p, a consumer once it equals p + 1. The two counters live
+// on separate cache lines so producers and consumers do not false-share.
+// Capacity is rounded up to a power of two.
+template <typename T>
+class mpmc_queue {
+public:
+    explicit mpmc_queue(std::size_t capacity);
+    ~mpmc_queue();
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    // false if the queue is full (item is left untouched) / empty
+    template <typename U>
+    bool try_push(U&& item);
+    bool try_pop(T& item);
+
+    // Spin, then yield, until there is room / an item
+    void push(T item);
+    T pop();
+
+    std::size_t capacity() const;
+    std::size_t size() const;   // Approximate under concurrent use
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr int SPINS = 64;
+
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* value() { return std::launder(reinterpret_cast<T*>(&storage)); }
+    };
+
+    std::unique_ptr<cell[]> buffer_;
+    std::size_t mask_;
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos_;
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos_;
+    char padding_[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+};
+
+// Constructor
+template <typename T>
+mpmc_queue<T>::mpmc_queue(std::size_t capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+    std::size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    buffer_.reset(new cell[size]);
+    mask_ = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+// Destructor
+template <typename T>
+mpmc_queue<T>::~mpmc_queue() {
+    const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+    for (std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+        buffer_[pos & mask_].value()->~T();
+    }
+}
+
+template <typename T>
+template <typename U>
+bool mpmc_queue<T>::try_push(U&& item) {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell& c = buffer_[pos & mask_];
+        const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                ::new (static_cast<void*>(&c.storage)) T(std::forward<U>(item));
+                c.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            return false;   // A lap behind: full
+        }
+        else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool mpmc_queue<T>::try_pop(T& item) {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell& c = buffer_[pos & mask_];
+        const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                item = std::move(*c.value());
+                c.value()->~T();
+                c.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            return false;   // Not written yet: empty
+        }
+        else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+void mpmc_queue<T>::push(T item) {
+    for (int spin = 0; !try_push(std::move(item)); ++spin) {
+        if (spin >= SPINS) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename T>
+T mpmc_queue<T>::pop() {
+    T item;
+    for (int spin = 0; !try_pop(item); ++spin) {
+        if (spin >= SPINS) {
+            std::this_thread::yield();
+        }
+    }
+
+    return item;
+}
+
+template <typename T>
+std::size_t mpmc_queue<T>::capacity() const {
+    return mask_ + 1;
+}
+
+template <typename T>
+std::size_t mpmc_queue<T>::size() const {
+    const std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+    const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+
+    return tail > head ? tail - head : 0;
+}
+
+#endif // MPMC_QUEUE_HPP
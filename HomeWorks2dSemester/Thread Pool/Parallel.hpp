@@ -0,0 +1,271 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include "Pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fork-join algorithms over a thread_pool. Ranges are split in halves until
+// they are at most `grain` long (0 picks one from the range and pool size);
+// one half is forked as a pool task, the other runs on the calling thread,
+// which then helps with queued tasks until its fork has finished. So the
+// caller does its share of the work, and the algorithms can be nested inside
+// pool tasks without tying up workers. The first exception thrown by a
+// piece of work is rethrown once every piece has finished.
+
+namespace detail {
+
+    // About 8 leaves per worker, the caller counted
+    template <typename Size>
+    std::size_t auto_grain(thread_pool& pool, Size size, std::size_t minimum = 1) {
+        const std::size_t leaves = 8 * (pool.worker_count() + 1);
+
+        return std::max(minimum, static_cast<std::size_t>(size) / leaves);
+    }
+
+    template <typename Predicate>
+    void help_until(thread_pool& pool, Predicate done) {
+        while (!done()) {
+            if (!pool.run_pending_task()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+} // namespace detail
+
+// Runs left on the calling thread and right on the pool, returns when both are done
+template <typename Left, typename Right>
+void parallel_invoke(thread_pool& pool, Left&& left, Right&& right) {
+    std::atomic<bool> right_done(false);
+    std::exception_ptr right_error;
+    pool.enqueue_detached([&right, &right_done, &right_error] {
+        try {
+            right();
+        }
+        catch (...) {
+            right_error = std::current_exception();
+        }
+        right_done.store(true, std::memory_order_release);
+    });
+
+    std::exception_ptr left_error;
+    try {
+        left();
+    }
+    catch (...) {
+        left_error = std::current_exception();
+    }
+
+    // right refers to this frame: wait for it even if left threw
+    detail::help_until(pool, [&right_done] { return right_done.load(std::memory_order_acquire); });
+    if (left_error) {
+        std::rethrow_exception(left_error);
+    }
+    if (right_error) {
+        std::rethrow_exception(right_error);
+    }
+}
+
+// Loops
+namespace detail {
+
+    template <typename Index, typename Body>
+    void parallel_for(thread_pool& pool, Index first, Index last, std::size_t grain, Body& body) {
+        if (static_cast<std::size_t>(last - first) <= grain) {
+            body(first, last);
+            return;
+        }
+
+        const Index middle = first + (last - first) / 2;
+        parallel_invoke(pool,
+            [&] { detail::parallel_for(pool, first, middle, grain, body); },
+            [&] { detail::parallel_for(pool, middle, last, grain, body); });
+    }
+
+    template <typename Index, typename T, typename Map, typename Combine>
+    T parallel_reduce(thread_pool& pool, Index first, Index last, std::size_t grain,
+                      const T& identity, Map& map, Combine& combine) {
+        if (static_cast<std::size_t>(last - first) <= grain) {
+            return map(first, last);
+        }
+
+        const Index middle = first + (last - first) / 2;
+        T left = identity;
+        T right = identity;
+        parallel_invoke(pool,
+            [&] { left = detail::parallel_reduce(pool, first, middle, grain, identity, map, combine); },
+            [&] { right = detail::parallel_reduce(pool, middle, last, grain, identity, map, combine); });
+
+        return combine(std::move(left), std::move(right));
+    }
+
+} // namespace detail
+
+// Calls body(chunk_first, chunk_last) on disjoint chunks covering [first, last)
+template <typename Index, typename Body>
+void parallel_for(thread_pool& pool, Index first, Index last, std::size_t grain, Body&& body) {
+    if (!(first < last)) {
+        return;
+    }
+
+    if (grain == 0) {
+        grain = detail::auto_grain(pool, last - first);
+    }
+    detail::parallel_for(pool, first, last, grain, body);
+}
+
+// combine(map(chunks)...) over [first, last); chunks are combined in range
+// order, so combine only needs to be associative
+template <typename Index, typename T, typename Map, typename Combine>
+T parallel_reduce(thread_pool& pool, Index first, Index last, std::size_t grain,
+                  const T& identity, Map&& map, Combine&& combine) {
+    if (!(first < last)) {
+        return identity;
+    }
+
+    if (grain == 0) {
+        grain = detail::auto_grain(pool, last - first);
+    }
+
+    return detail::parallel_reduce(pool, first, last, grain, identity, map, combine);
+}
+
+// Scan
+// Inclusive scan of [first, last) into out (which may be first) with an
+// associative op: block totals in parallel, a serial scan over the blocks,
+// then every block rescanned from its offset in parallel. Returns the end of
+// the output.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt parallel_scan(thread_pool& pool, InputIt first, InputIt last, OutputIt out,
+                       std::size_t grain, const T& identity, BinaryOp op) {
+    const std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+    if (size == 0) {
+        return out;
+    }
+
+    if (grain == 0) {
+        grain = detail::auto_grain(pool, size, 1024);
+    }
+
+    const std::size_t blocks = (size + grain - 1) / grain;
+    std::vector<T> offsets(blocks, identity);
+    parallel_for(pool, std::size_t(0), blocks, 1, [&](std::size_t block_first, std::size_t block_last) {
+        for (std::size_t b = block_first; b < block_last; ++b) {
+            const InputIt begin = first + b * grain;
+            const InputIt end = first + std::min(size, (b + 1) * grain);
+            T total = identity;
+            for (InputIt it = begin; it != end; ++it) {
+                total = op(total, *it);
+            }
+            offsets[b] = total;
+        }
+    });
+
+    T running = identity;
+    for (T& offset : offsets) {
+        T total = op(running, offset);
+        offset = running;
+        running = std::move(total);
+    }
+
+    parallel_for(pool, std::size_t(0), blocks, 1, [&](std::size_t block_first, std::size_t block_last) {
+        for (std::size_t b = block_first; b < block_last; ++b) {
+            T total = offsets[b];
+            OutputIt to = out + b * grain;
+            const InputIt end = first + std::min(size, (b + 1) * grain);
+            for (InputIt it = first + b * grain; it != end; ++it, ++to) {
+                total = op(total, *it);
+                *to = total;
+            }
+        }
+    });
+
+    return out + size;
+}
+
+// Sort
+namespace detail {
+
+    // Moves the merge of two sorted ranges to out, splitting at the median
+    // of the longer range
+    template <typename It, typename OutputIt, typename Compare>
+    void parallel_merge(thread_pool& pool, It first1, It last1, It first2, It last2,
+                        OutputIt out, std::size_t grain, Compare& comp) {
+        if (last1 - first1 < last2 - first2) {
+            std::swap(first1, first2);
+            std::swap(last1, last2);
+        }
+
+        if (static_cast<std::size_t>((last1 - first1) + (last2 - first2)) <= grain || first2 == last2) {
+            std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+                       std::make_move_iterator(first2), std::make_move_iterator(last2), out, comp);
+            return;
+        }
+
+        const It middle1 = first1 + (last1 - first1) / 2;
+        const It middle2 = std::lower_bound(first2, last2, *middle1, comp);
+        const OutputIt middle_out = out + (middle1 - first1) + (middle2 - first2);
+        parallel_invoke(pool,
+            [&] { detail::parallel_merge(pool, first1, middle1, first2, middle2, out, grain, comp); },
+            [&] { detail::parallel_merge(pool, middle1, last1, middle2, last2, middle_out, grain, comp); });
+    }
+
+    // Merge sort that ping-pongs between data and buffer; the sorted result
+    // ends up in data if in_place, otherwise in buffer
+    template <typename It, typename BufferIt, typename Compare>
+    void parallel_sort(thread_pool& pool, It data, BufferIt buffer, std::size_t size,
+                       bool in_place, std::size_t grain, Compare& comp) {
+        if (size <= grain) {
+            std::sort(data, data + size, comp);
+            if (!in_place) {
+                std::move(data, data + size, buffer);
+            }
+            return;
+        }
+
+        const std::size_t half = size / 2;
+        parallel_invoke(pool,
+            [&] { detail::parallel_sort(pool, data, buffer, half, !in_place, grain, comp); },
+            [&] { detail::parallel_sort(pool, data + half, buffer + half, size - half, !in_place, grain, comp); });
+
+        if (in_place) {
+            detail::parallel_merge(pool, buffer, buffer + half, buffer + half, buffer + size, data, grain, comp);
+        }
+        else {
+            detail::parallel_merge(pool, data, data + half, data + half, data + size, buffer, grain, comp);
+        }
+    }
+
+} // namespace detail
+
+// Unstable sort of a random-access range, with a temporary copy of it
+template <typename RandomIt, typename Compare>
+void parallel_sort(thread_pool& pool, RandomIt first, RandomIt last, Compare comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const std::size_t grain = detail::auto_grain(pool, size, 4096);
+    if (size <= grain) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // Sorted from the buffer back into the range, so no default-constructed values are needed
+    std::vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+    detail::parallel_sort(pool, buffer.begin(), first, size, false, grain, comp);
+}
+
+template <typename RandomIt>
+void parallel_sort(thread_pool& pool, RandomIt first, RandomIt last) {
+    parallel_sort(pool, first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+#endif // PARALLEL_HPP
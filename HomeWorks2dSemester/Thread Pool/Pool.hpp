@@ -1,61 +1,378 @@
 #ifndef THREAD_POOL_HPP
 #define THREAD_POOL_HPP
 
+#include "WorkStealingDeque.hpp"
+#include "MpmcQueue.hpp"
+#include "BlockPool.hpp"
+#include "Task.hpp"
+#include "Topology.hpp"
+#include "Statistics.hpp"
+
 #include <mutex>
 #include <thread>
-#include <queue>
+#include <chrono>
+#include <array>
 #include <functional>
 #include <future>
 #include <condition_variable>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 #include <stdexcept>
 #include <type_traits>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <ostream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
 
+// Work-stealing thread pool. Every worker owns a Chase-Lev deque: tasks
+// submitted from a worker go to the bottom of its own deque and are popped
+// LIFO, idle workers steal from the top of a random victim's deque. Tasks
+// submitted from outside, or with task_options, go to one queue per
+// priority class: a bounded lock-free FIFO, plus a min-heap for tasks with a
+// deadline, which run first within their class, earliest first (see
+// overflow_policy for what happens when a class is full). Workers take high
+// priority work first, then their own deque, then normal and low priority
+// work, then steal; a lower class that has gone unserved for the aging
+// limit (times its distance from high) is taken ahead of everything else.
+// Workers with nothing to run or steal spin for a short while, then sleep
+// on condition_ until pending_ says there is work again.
+//
+// The worker count is elastic between worker_limits' min and max: a
+// submission that finds more tasks pending than workers, and none of them
+// idle, starts another worker, and a worker above the minimum that has
+// slept for keep_alive exits.
+//
+// Workers are spread over the NUMA nodes of cpu_topology, slot i on node
+// i % nodes, and can be pinned to their node or to one CPU of it. Each node
+// has its own FIFO for tasks bound to it (task_options::node,
+// submit_on_node). Workers steal within their node first; only when it has
+// no work do they take other nodes' tasks.
+//
+// statistics() adds up per-thread counters (see Statistics.hpp); with
+// set_timing() on, or between start_trace() and stop_trace(), every task is
+// also timed, for latency histograms, busy/idle time and trace spans.
+//
+// Tasks are pool-allocated task nodes (see Task.hpp, BlockPool.hpp); with a
+// small closure enqueue_detached allocates nothing from the heap once the
+// freelists are warm, and enqueue only adds the pooled future state.
 class thread_pool {
 public:
-    explicit thread_pool(std::size_t threads);
+    // What a submission from outside the pool does when its class queue is
+    // full (capacity is per class). Submissions from inside pool tasks never
+    // wait, since a worker blocking on its own pool could deadlock: without
+    // options they go to the worker's own deque, and with options they run
+    // in the caller when their class is full.
+    enum class overflow_policy {
+        block,           // Wait until a worker takes a task
+        reject,          // Throw std::runtime_error
+        run_in_caller    // Run the task on the submitting thread
+    };
+
+    enum class priority {
+        high,
+        normal,
+        low
+    };
+
+    static constexpr std::size_t PRIORITIES = 3;
+
+    // Where workers may run
+    enum class affinity {
+        none,    // Wherever the OS puts them
+        node,    // On any CPU of their node
+        core     // On one CPU of their node, round-robin
+    };
+
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t ANY_NODE = static_cast<std::size_t>(-1);
+
+    // A task bound to a node goes to that node's FIFO, ahead of normal and
+    // low priority work for its workers; level and deadline do not apply.
+    struct task_options {
+        priority level = priority::normal;
+        clock::time_point deadline = clock::time_point::max();   // None by default
+        std::size_t node = ANY_NODE;
+        const char* label = nullptr;   // Names the task's trace spans; must outlive the trace
+    };
+
+    // Per priority class. Tasks submitted from a worker without options run
+    // from its deque and are not counted.
+    struct queue_metrics {
+        std::size_t depth = 0;                 // Waiting now
+        std::uint64_t submitted = 0;
+        std::uint64_t started = 0;
+        std::uint64_t missed_deadlines = 0;    // Started after their deadline
+        std::chrono::nanoseconds mean_wait{0}; // Submission to start
+        std::chrono::nanoseconds max_wait{0};
+    };
+
+    // Keeps enqueue_detached(options, ...) from taking options as the callable
+    template <typename Func>
+    using if_not_options = typename std::enable_if<
+        !std::is_same<typename std::decay<Func>::type, task_options>::value>::type;
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr std::chrono::milliseconds DEFAULT_AGING{10};
+    static constexpr std::chrono::microseconds DEFAULT_SPIN{50};
+    static constexpr std::chrono::seconds DEFAULT_KEEP_ALIVE{1};
+
+    struct worker_limits {
+        std::size_t min_threads;
+        std::size_t max_threads;
+        clock::duration keep_alive = DEFAULT_KEEP_ALIVE;   // Idle time before an extra worker exits
+        affinity pin = affinity::none;
+        const cpu_topology* topology = nullptr;   // Nodes to spread over; cpu_topology::current() if null
+    };
+
+    // A fixed number of workers
+    explicit thread_pool(std::size_t threads, std::size_t capacity = DEFAULT_CAPACITY,
+                         overflow_policy policy = overflow_policy::block);
+
+    // Starts min_threads workers, grows up to max_threads under load.
+    // Throws std::invalid_argument if min_threads > max_threads or the
+    // topology has an empty node.
+    explicit thread_pool(worker_limits workers, std::size_t capacity = DEFAULT_CAPACITY,
+                         overflow_policy policy = overflow_policy::block);
     ~thread_pool();
 
     template <typename Func, typename... Args>
     auto enqueue(Func&& func, Args&&... args) -> std::future<typename std::result_of<Func(Args...)>::type>;
 
+    // With a priority class and optionally a deadline. A task past its
+    // deadline still runs; it is counted in missed_deadlines.
+    template <typename Func, typename... Args>
+    auto enqueue(const task_options& options, Func&& func, Args&&... args)
+        -> std::future<typename std::result_of<Func(Args...)>::type>;
+
+    // Fire-and-forget: no future, so an exception escaping func terminates
+    // the program, as it would on a std::thread
+    template <typename Func, typename... Args>
+    auto enqueue_detached(Func&& func, Args&&... args) -> if_not_options<Func>;
+
+    template <typename Func, typename... Args>
+    void enqueue_detached(const task_options& options, Func&& func, Args&&... args);
+
+    // enqueue() bound to a node, so memory it allocates and touches stays
+    // local. Throws std::invalid_argument if there is no such node.
+    template <typename Func, typename... Args>
+    auto submit_on_node(std::size_t node, Func&& func, Args&&... args)
+        -> std::future<typename std::result_of<Func(Args...)>::type>;
+
+    std::size_t node_count() const;
+
+    queue_metrics metrics(priority level) const;
+    void reset_metrics();
+
+    // How long normal priority work may wait behind high priority work
+    // before it is served anyway (twice that for low priority)
+    void set_aging(clock::duration limit);
+
+    // How long a worker that runs out of work polls for more before it
+    // sleeps. Trades CPU for wake-up latency; 0 on a single hardware thread,
+    // where spinning only delays the thread that would submit the work.
+    void set_spin(clock::duration limit);
+
+    // `co_await pool.schedule()` moves a coroutine onto a worker. Templated
+    // on the handle type so this header stays usable without C++20.
+    struct schedule_awaiter {
+        thread_pool& pool;
+
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Handle>
+        void await_suspend(Handle handle) const {
+            pool.enqueue_detached([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    schedule_awaiter schedule();
+
+    // Runs one queued task on the calling thread, if any is queued or can
+    // be stolen. Lets a thread waiting on pool work help instead of block.
+    bool run_pending_task();
+
+    // Hardware threads of the machine (at least 1)
     std::size_t hardware_capability() const;
 
+    // Workers running now
+    std::size_t worker_count() const;
+
+    // Instrumentation
+    pool_statistics statistics() const;
+    void reset_statistics();
+
+    // Timestamps every task at submission, start and end. Off by default:
+    // it costs a clock read per submission and two per task.
+    void set_timing(bool enabled);
+
+    // Records a span per task run from now on (timed, whatever
+    // set_timing() says) until stop_trace(); start_trace() drops earlier
+    // spans. Spans are kept in memory until then.
+    void start_trace();
+    void stop_trace();
+
+    // The recorded spans as Chrome trace event JSON (chrome://tracing, Perfetto)
+    void write_trace(std::ostream& out) const;
+
 private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    const std::size_t cores_;
+    struct task_node {
+        task work;
+        clock::time_point queued;
+        clock::time_point deadline;
+        priority level;
+        std::size_t home;   // Node it is bound to, or ANY_NODE
+        const char* label;
+    };
+
+    // Orders the deadline heap earliest first
+    static bool later_deadline(const task_node* a, const task_node* b) { return a->deadline > b->deadline; }
+
+    struct class_queue {
+        explicit class_queue(std::size_t capacity) : fifo(capacity) {}
+
+        std::size_t depth() const { return fifo.size() + deadline_count.load(); }
+
+        mpmc_queue<task_node*> fifo;
+        std::mutex deadline_mutex;
+        std::vector<task_node*> deadlines;            // Min-heap on deadline
+        std::atomic<std::size_t> deadline_count{0};
+        std::atomic<clock::rep> last_service{0};      // When a task was last taken
+
+        std::atomic<std::uint64_t> submitted{0};
+        std::atomic<std::uint64_t> started{0};
+        std::atomic<std::uint64_t> missed{0};
+        std::atomic<std::uint64_t> wait_total{0};     // Clock ticks
+        std::atomic<std::uint64_t> wait_max{0};
+    };
+
+    // One per possible worker, all made up front so stealers can index
+    // them without locking; thread and running are guarded by grow_mutex_
+    struct worker_queue {
+        work_stealing_deque<task_node*> deque;
+        std::thread thread;
+        std::atomic<bool> running{false};
+        std::size_t node = 0;
+        int cpu = 0;   // For affinity::core
+        detail::thread_counters counters;
+    };
+
+    // Worker of the calling thread, so submissions from tasks stay local
+    // (zero-initialised: no pool), and its victim selection state
+    struct worker_context {
+        thread_pool* pool;
+        std::size_t index;
+        std::uint32_t seed;   // xorshift state
+    };
+    inline static thread_local worker_context context_;
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    const std::size_t min_threads_;
+    const std::size_t max_threads_;
+    const clock::duration keep_alive_;
+    std::atomic<std::size_t> live_;      // Running workers
+    std::atomic<std::size_t> slots_;     // Highest slot used + 1, bounds steal sweeps
+    std::mutex grow_mutex_;
+    std::atomic<clock::rep> spin_;
 
-    std::mutex queue_mutex_;
+    const cpu_topology topology_;
+    const affinity pin_;
+    std::vector<std::unique_ptr<mpmc_queue<task_node*>>> nodes_;   // Tasks bound to each node
+
+    std::array<std::unique_ptr<class_queue>, PRIORITIES> classes_;
+    std::atomic<clock::rep> aging_;
+    const overflow_policy policy_;
+    std::atomic<std::size_t> blocked_;   // Submitters waiting for room
+    std::mutex space_mutex_;
+    std::condition_variable space_;
+
+    std::atomic<std::size_t> pending_;   // Queued, not yet taken
+    std::atomic<std::size_t> idle_;      // Workers about to sleep or sleeping
+    std::mutex sleep_mutex_;
     std::condition_variable condition_;
-    bool stop_;
+    std::atomic<bool> stop_;
+
+    std::unique_ptr<detail::thread_counters> outside_;   // Shared by threads outside the pool
+    std::atomic<std::size_t> high_water_;
+    std::atomic<bool> timing_;
+    std::atomic<bool> tracing_;
+    std::atomic<clock::rep> trace_start_;
+
+    template <typename Func>
+    static task_node* make_task(Func&& func);
+    static void free_task(task_node* node);
+
+    template <typename Func, typename... Args>
+    auto enqueue_with(const task_options* options, Func&& func, Args&&... args)
+        -> std::future<typename std::result_of<Func(Args...)>::type>;
+    template <typename Func, typename... Args>
+    void enqueue_detached_with(const task_options* options, Func&& func, Args&&... args);
+
+    detail::thread_counters& counters();
+    bool timed() const;
+    void run(task_node* task);
+    void submit(task_node* node, const task_options* options);
+    bool inject(task_node* node);
+    void overflow(task_node* node);
+    task_node* take(std::size_t index);
+    task_node* take_class(std::size_t level);
+    task_node* take_node(std::size_t node);
+    task_node* steal(std::size_t index);
+    void grow();
+    bool retire();
+    void start_worker(std::size_t index);
+    void pin_worker(std::size_t index);
+    void worker_loop(std::size_t index);
 };
 
 // Constructor
-thread_pool::thread_pool(std::size_t threads)
-    : cores_(threads), stop_(false) {
-    for (std::size_t i = 0; i < threads; ++i) {
-        workers_.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(this->queue_mutex_);
-                    this->condition_.wait(lock, [this] {
-                        return this->stop_ || !this->tasks_.empty();
-                    });
-
-                    if (this->stop_ && this->tasks_.empty()){
-                        return;
-                    }
-                    
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop();
-                }
+inline thread_pool::thread_pool(std::size_t threads, std::size_t capacity, overflow_policy policy)
+    : thread_pool(worker_limits{threads, threads}, capacity, policy) {}
 
-                task();
-            }
-        });
+inline thread_pool::thread_pool(worker_limits workers, std::size_t capacity, overflow_policy policy)
+    : min_threads_(workers.min_threads), max_threads_(workers.max_threads), keep_alive_(workers.keep_alive),
+      live_(0), slots_(0),
+      spin_(std::thread::hardware_concurrency() > 1 ? std::chrono::duration_cast<clock::duration>(DEFAULT_SPIN).count() : 0),
+      topology_(workers.topology ? *workers.topology : cpu_topology::current()), pin_(workers.pin),
+      aging_(std::chrono::duration_cast<clock::duration>(DEFAULT_AGING).count()),
+      policy_(policy), blocked_(0), pending_(0), idle_(0), stop_(false),
+      outside_(new detail::thread_counters()), high_water_(0), timing_(false), tracing_(false), trace_start_(0) {
+    if (min_threads_ > max_threads_) {
+        throw std::invalid_argument("thread_pool: min_threads > max_threads");
+    }
+    if (topology_.nodes.empty() || std::any_of(topology_.nodes.begin(), topology_.nodes.end(),
+                                               [](const std::vector<int>& cpus) { return cpus.empty(); })) {
+        throw std::invalid_argument("thread_pool: topology needs nodes with CPUs");
+    }
+
+    for (std::unique_ptr<class_queue>& queue : classes_) {
+        queue.reset(new class_queue(capacity));
+        queue->last_service.store(clock::now().time_since_epoch().count());
+    }
+
+    for (std::size_t i = 0; i < topology_.nodes.size(); ++i) {
+        nodes_.emplace_back(new mpmc_queue<task_node*>(capacity));
+    }
+
+    for (std::size_t i = 0; i < max_threads_; ++i) {
+        queues_.emplace_back(new worker_queue());
+        const std::vector<int>& cpus = topology_.nodes[i % topology_.nodes.size()];
+        queues_[i]->node = i % topology_.nodes.size();
+        queues_[i]->cpu = cpus[i / topology_.nodes.size() % cpus.size()];
+    }
+
+    std::unique_lock<std::mutex> lock(grow_mutex_);
+    for (std::size_t i = 0; i < min_threads_; ++i) {
+        start_worker(i);
     }
 }
 
@@ -63,44 +380,695 @@ thread_pool::thread_pool(std::size_t threads)
 template <typename Func, typename... Args>
 auto thread_pool::enqueue(Func&& func, Args&&... args)
     -> std::future<typename std::result_of<Func(Args...)>::type> {
+    return enqueue_with(nullptr, std::forward<Func>(func), std::forward<Args>(args)...);
+}
 
-    using return_type = typename std::result_of<Func(Args...)>::type;
+template <typename Func, typename... Args>
+auto thread_pool::enqueue(const task_options& options, Func&& func, Args&&... args)
+    -> std::future<typename std::result_of<Func(Args...)>::type> {
+    return enqueue_with(&options, std::forward<Func>(func), std::forward<Args>(args)...);
+}
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<Func>(func), std::forward<Args>(args)...)
-    );
+template <typename Func, typename... Args>
+auto thread_pool::enqueue_detached(Func&& func, Args&&... args) -> if_not_options<Func> {
+    enqueue_detached_with(nullptr, std::forward<Func>(func), std::forward<Args>(args)...);
+}
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        if (stop_)
-            throw std::runtime_error("enqueue on stopped thread_pool");
+template <typename Func, typename... Args>
+void thread_pool::enqueue_detached(const task_options& options, Func&& func, Args&&... args) {
+    enqueue_detached_with(&options, std::forward<Func>(func), std::forward<Args>(args)...);
+}
 
-        tasks_.emplace([task]() { (*task)(); });
-    }
+template <typename Func, typename... Args>
+auto thread_pool::submit_on_node(std::size_t node, Func&& func, Args&&... args)
+    -> std::future<typename std::result_of<Func(Args...)>::type> {
+    task_options options;
+    options.node = node;
+
+    return enqueue_with(&options, std::forward<Func>(func), std::forward<Args>(args)...);
+}
+
+template <typename Func, typename... Args>
+auto thread_pool::enqueue_with(const task_options* options, Func&& func, Args&&... args)
+    -> std::future<typename std::result_of<Func(Args...)>::type> {
+
+    using return_type = typename std::result_of<Func(Args...)>::type;
+
+    // Promise state comes from block_pool; func and args are moved into the
+    // closure instead of going through std::bind and std::function
+    std::promise<return_type> promise(std::allocator_arg, pool_allocator<return_type>());
+    std::future<return_type> res = promise.get_future();
+    submit(make_task([promise = std::move(promise),
+                      call = std::make_tuple(std::forward<Func>(func), std::forward<Args>(args)...)]() mutable {
+        try {
+            if constexpr (std::is_void<return_type>::value) {
+                std::apply([](auto&... parts) { std::invoke(std::move(parts)...); }, call);
+                promise.set_value();
+            }
+            else {
+                promise.set_value(std::apply([](auto&... parts) { return std::invoke(std::move(parts)...); }, call));
+            }
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }), options);
 
-    condition_.notify_one();
     return res;
 }
 
+template <typename Func, typename... Args>
+void thread_pool::enqueue_detached_with(const task_options* options, Func&& func, Args&&... args) {
+    if constexpr (sizeof...(Args) == 0) {
+        submit(make_task(std::forward<Func>(func)), options);
+    }
+    else {
+        submit(make_task([call = std::make_tuple(std::forward<Func>(func), std::forward<Args>(args)...)]() mutable {
+            std::apply([](auto&... parts) { std::invoke(std::move(parts)...); }, call);
+        }), options);
+    }
+}
+
 // Destructor
-thread_pool::~thread_pool() {
+inline thread_pool::~thread_pool() {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_ = true;
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
     }
-    
+
     condition_.notify_all();
-    for (std::thread& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+
+    // grow() checks stop_ under grow_mutex_: once this has it, no worker starts
+    { std::unique_lock<std::mutex> lock(grow_mutex_); }
+    for (std::unique_ptr<worker_queue>& queue : queues_) {
+        if (queue->thread.joinable()) {
+            queue->thread.join();
+        }
+    }
+}
+
+inline thread_pool::schedule_awaiter thread_pool::schedule() {
+    return schedule_awaiter{*this};
+}
+
+inline bool thread_pool::run_pending_task() {
+    // Threads outside the pool have no deque: index past the last worker
+    task_node* task = take(context_.pool == this ? context_.index : queues_.size());
+    if (!task) {
+        return false;
+    }
+
+    run(task);
+
+    return true;
+}
+
+inline std::size_t thread_pool::hardware_capability() const {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+inline std::size_t thread_pool::worker_count() const {
+    return live_.load();
+}
+
+inline std::size_t thread_pool::node_count() const {
+    return nodes_.size();
+}
+
+// Metrics
+inline thread_pool::queue_metrics thread_pool::metrics(priority level) const {
+    const class_queue& queue = *classes_[static_cast<std::size_t>(level)];
+    queue_metrics result;
+    result.depth = queue.depth();
+    result.submitted = queue.submitted.load(std::memory_order_relaxed);
+    result.started = queue.started.load(std::memory_order_relaxed);
+    result.missed_deadlines = queue.missed.load(std::memory_order_relaxed);
+    if (result.started > 0) {
+        const clock::duration mean(static_cast<clock::rep>(queue.wait_total.load(std::memory_order_relaxed) / result.started));
+        result.mean_wait = std::chrono::duration_cast<std::chrono::nanoseconds>(mean);
+    }
+    const clock::duration max(static_cast<clock::rep>(queue.wait_max.load(std::memory_order_relaxed)));
+    result.max_wait = std::chrono::duration_cast<std::chrono::nanoseconds>(max);
+
+    return result;
+}
+
+inline void thread_pool::reset_metrics() {
+    for (std::unique_ptr<class_queue>& queue : classes_) {
+        queue->submitted.store(0, std::memory_order_relaxed);
+        queue->started.store(0, std::memory_order_relaxed);
+        queue->missed.store(0, std::memory_order_relaxed);
+        queue->wait_total.store(0, std::memory_order_relaxed);
+        queue->wait_max.store(0, std::memory_order_relaxed);
+    }
+}
+
+inline void thread_pool::set_aging(clock::duration limit) {
+    aging_.store(limit.count(), std::memory_order_relaxed);
+}
+
+inline void thread_pool::set_spin(clock::duration limit) {
+    spin_.store(limit.count(), std::memory_order_relaxed);
+}
+
+// Instrumentation
+inline pool_statistics thread_pool::statistics() const {
+    pool_statistics result;
+    result.pending = pending_.load();
+    result.pending_high_water = high_water_.load(std::memory_order_relaxed);
+    result.workers.resize(queues_.size());
+    for (std::size_t i = 0; i <= queues_.size(); ++i) {
+        const detail::thread_counters& counters = i < queues_.size() ? queues_[i]->counters : *outside_;
+        pool_statistics::thread& thread = i < queues_.size() ? result.workers[i] : result.outside;
+        counters.add_to(thread);
+        counters.wait.add_to(result.wait);
+        counters.run.add_to(result.run);
+        result.submitted += thread.submitted;
+        result.completed += thread.completed;
+        result.steals += thread.steals;
+    }
+
+    return result;
+}
+
+inline void thread_pool::reset_statistics() {
+    for (std::unique_ptr<worker_queue>& queue : queues_) {
+        queue->counters.reset();
+    }
+    outside_->reset();
+    high_water_.store(pending_.load(), std::memory_order_relaxed);
+}
+
+inline void thread_pool::set_timing(bool enabled) {
+    timing_.store(enabled, std::memory_order_relaxed);
+}
+
+inline void thread_pool::start_trace() {
+    for (std::size_t i = 0; i <= queues_.size(); ++i) {
+        detail::thread_counters& counters = i < queues_.size() ? queues_[i]->counters : *outside_;
+        std::unique_lock<std::mutex> lock(counters.trace_mutex);
+        counters.trace.clear();
+    }
+
+    trace_start_.store(clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    tracing_.store(true);
+}
+
+inline void thread_pool::stop_trace() {
+    tracing_.store(false);
+}
+
+// Worker slots are trace threads 0..n-1, threads outside the pool thread n
+inline void thread_pool::write_trace(std::ostream& out) const {
+    std::vector<std::vector<detail::trace_span>> threads(queues_.size() + 1);
+    std::vector<std::string> names(queues_.size() + 1);
+    for (std::size_t i = 0; i <= queues_.size(); ++i) {
+        detail::thread_counters& counters = i < queues_.size() ? queues_[i]->counters : *outside_;
+        std::unique_lock<std::mutex> lock(counters.trace_mutex);
+        threads[i] = counters.trace;
+        names[i] = i < queues_.size() ? "worker " + std::to_string(i) : "outside the pool";
+    }
+
+    std::vector<const char*> labels;
+    for (const std::string& name : names) {
+        labels.push_back(name.c_str());
+    }
+    detail::write_chrome_trace(out, threads, labels);
+}
+
+// Task nodes
+template <typename Func>
+thread_pool::task_node* thread_pool::make_task(Func&& func) {
+    void* memory = block_pool::allocate(sizeof(task_node));
+    try {
+        return ::new (memory) task_node{task(std::forward<Func>(func)), {}, clock::time_point::max(), priority::normal, ANY_NODE, nullptr};
+    }
+    catch (...) {
+        block_pool::deallocate(memory, sizeof(task_node));
+        throw;
+    }
+}
+
+inline void thread_pool::free_task(task_node* node) {
+    node->~task_node();
+    block_pool::deallocate(node, sizeof(task_node));
+}
+
+// Scheduling
+// The calling thread's counter block
+inline detail::thread_counters& thread_pool::counters() {
+    return context_.pool == this ? queues_[context_.index]->counters : *outside_;
+}
+
+inline bool thread_pool::timed() const {
+    return timing_.load(std::memory_order_relaxed) || tracing_.load(std::memory_order_relaxed);
+}
+
+// Runs a taken task and frees it, with the bookkeeping for statistics
+inline void thread_pool::run(task_node* task) {
+    pending_.fetch_sub(1);
+    detail::thread_counters& counters = this->counters();
+    if (!timed()) {
+        task->work();
+        free_task(task);
+        counters.completed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // The node is gone once it has run: keep what the records need
+    const clock::time_point queued = task->queued;
+    const char* label = task->label;
+    const clock::time_point start = clock::now();
+    task->work();
+    free_task(task);
+    const clock::time_point end = clock::now();
+
+    const std::chrono::nanoseconds duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    const std::chrono::nanoseconds wait = std::chrono::duration_cast<std::chrono::nanoseconds>(start - queued);
+    const bool stamped = queued != clock::time_point();
+    counters.completed.fetch_add(1, std::memory_order_relaxed);
+    counters.busy.fetch_add(duration.count(), std::memory_order_relaxed);
+    counters.run.record(duration);
+    if (stamped) {
+        counters.wait.record(wait);
+    }
+
+    if (tracing_.load(std::memory_order_relaxed)) {
+        const clock::time_point trace_start{clock::duration(trace_start_.load(std::memory_order_relaxed))};
+        if (start >= trace_start) {
+            std::unique_lock<std::mutex> lock(counters.trace_mutex);
+            counters.trace.push_back(detail::trace_span{
+                label, std::chrono::duration_cast<std::chrono::nanoseconds>(start - trace_start).count(),
+                duration.count(), stamped ? wait.count() : -1});
+        }
+    }
+}
+
+inline void thread_pool::submit(task_node* node, const task_options* options) {
+    if (options && options->node != ANY_NODE && options->node >= nodes_.size()) {
+        free_task(node);
+        throw std::invalid_argument("thread_pool: no such node");
+    }
+
+    // Counted before it becomes visible, so a taker never sees pending_ at 0
+    const std::size_t depth = pending_.fetch_add(1) + 1;
+    std::size_t high_water = high_water_.load(std::memory_order_relaxed);
+    while (depth > high_water && !high_water_.compare_exchange_weak(high_water, depth, std::memory_order_relaxed)) {
+    }
+
+    if (live_.load() < max_threads_ && idle_.load() == 0 && depth > live_.load()) {
+        grow();
+    }
+    if (!options && context_.pool == this) {
+        if (timed()) {
+            node->queued = clock::now();
+        }
+        queues_[context_.index]->deque.push(node);
+    }
+    else {
+        if (stop_.load()) {
+            pending_.fetch_sub(1);
+            free_task(node);
+            throw std::runtime_error("enqueue on stopped thread_pool");
+        }
+
+        if (options) {
+            node->level = options->level;
+            node->deadline = options->deadline;
+            node->home = options->node;
+            node->label = options->label;
+        }
+        node->queued = clock::now();
+        if (!inject(node)) {
+            overflow(node);
+            counters().submitted.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    counters().submitted.fetch_add(1, std::memory_order_relaxed);
+
+    // A worker that found nothing registers as idle before re-checking
+    // pending_ under sleep_mutex_, so this cannot miss it
+    if (idle_.load() > 0) {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        condition_.notify_one();
+    }
+}
+
+// Into the task's node or class queue; false if that is full
+inline bool thread_pool::inject(task_node* node) {
+    if (node->home != ANY_NODE) {
+        return nodes_[node->home]->try_push(node);
+    }
+
+    // Read before the push: from then on a worker may run and free the node
+    class_queue& queue = *classes_[static_cast<std::size_t>(node->level)];
+    const clock::rep queued = node->queued.time_since_epoch().count();
+    const bool was_empty = queue.depth() == 0;
+    if (node->deadline != clock::time_point::max()) {
+        std::unique_lock<std::mutex> lock(queue.deadline_mutex);
+        if (queue.deadlines.size() >= queue.fifo.capacity()) {
+            return false;
+        }
+
+        queue.deadlines.push_back(node);
+        std::push_heap(queue.deadlines.begin(), queue.deadlines.end(), later_deadline);
+        queue.deadline_count.fetch_add(1);
+    }
+    else if (!queue.fifo.try_push(node)) {
+        return false;
+    }
+
+    // An idle class has not been starved: its wait starts now
+    if (was_empty) {
+        queue.last_service.store(queued, std::memory_order_relaxed);
+    }
+    queue.submitted.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+// Class queue full; node is already counted in pending_
+inline void thread_pool::overflow(task_node* node) {
+    if (policy_ == overflow_policy::reject && context_.pool != this) {
+        pending_.fetch_sub(1);
+        free_task(node);
+        throw std::runtime_error("thread_pool queue is full");
+    }
+
+    if (policy_ == overflow_policy::run_in_caller || context_.pool == this) {
+        run(node);
+        return;
+    }
+
+    // Block: yield to the workers for a while, then park. Once blocked_ is
+    // non-zero, takers wake the parked submitters when a class has drained
+    // to half (not on every pop, which would cost a wake-up per task); the
+    // retry runs under space_mutex_, so that wake-up cannot be missed.
+    bool pushed = false;
+    for (int i = 0; i < 64 && !pushed; ++i) {
+        std::this_thread::yield();
+        pushed = inject(node);
+    }
+    if (!pushed) {
+        blocked_.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(space_mutex_);
+            space_.wait(lock, [this, node] { return inject(node); });
+        }
+        blocked_.fetch_sub(1);
+    }
+
+    if (idle_.load() > 0) {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        condition_.notify_one();
+    }
+}
+
+inline thread_pool::task_node* thread_pool::take(std::size_t index) {
+    task_node* task = nullptr;
+
+    // Aging: a class unserved for aging_ per level below high goes first
+    const clock::rep aging = aging_.load(std::memory_order_relaxed);
+    clock::rep now = 0;
+    for (std::size_t level = 1; level < PRIORITIES; ++level) {
+        const class_queue& queue = *classes_[level];
+        if (queue.depth() == 0) {
+            continue;
+        }
+
+        if (now == 0) {
+            now = clock::now().time_since_epoch().count();
+        }
+        if (now - queue.last_service.load(std::memory_order_relaxed) > aging * static_cast<clock::rep>(level)
+            && (task = take_class(level))) {
+            return task;
+        }
+    }
+
+    if ((task = take_class(static_cast<std::size_t>(priority::high)))) {
+        return task;
+    }
+
+    if (index < queues_.size() && queues_[index]->deque.pop(task)) {
+        return task;
+    }
+
+    if (index < queues_.size() && (task = take_node(queues_[index]->node))) {
+        return task;
+    }
+
+    for (std::size_t level = 1; level < PRIORITIES; ++level) {
+        if ((task = take_class(level))) {
+            return task;
+        }
+    }
+
+    return steal(index);
+}
+
+// Deadline heap first, then the FIFO; records the wait
+inline thread_pool::task_node* thread_pool::take_class(std::size_t level) {
+    class_queue& queue = *classes_[level];
+    task_node* task = nullptr;
+    if (queue.deadline_count.load() > 0) {
+        std::unique_lock<std::mutex> lock(queue.deadline_mutex);
+        if (!queue.deadlines.empty()) {
+            std::pop_heap(queue.deadlines.begin(), queue.deadlines.end(), later_deadline);
+            task = queue.deadlines.back();
+            queue.deadlines.pop_back();
+            queue.deadline_count.fetch_sub(1);
         }
     }
+    if (!task && !queue.fifo.try_pop(task)) {
+        return nullptr;
+    }
+
+    const clock::time_point now = clock::now();
+    const std::uint64_t wait = static_cast<std::uint64_t>(std::max<clock::rep>(0, (now - task->queued).count()));
+    queue.started.fetch_add(1, std::memory_order_relaxed);
+    queue.wait_total.fetch_add(wait, std::memory_order_relaxed);
+    std::uint64_t longest = queue.wait_max.load(std::memory_order_relaxed);
+    while (wait > longest && !queue.wait_max.compare_exchange_weak(longest, wait, std::memory_order_relaxed)) {
+    }
+    if (now > task->deadline) {
+        queue.missed.fetch_add(1, std::memory_order_relaxed);
+    }
+    queue.last_service.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+
+    if (blocked_.load() > 0 && queue.depth() <= queue.fifo.capacity() / 2) {
+        std::unique_lock<std::mutex> lock(space_mutex_);
+        space_.notify_all();
+    }
+
+    return task;
 }
 
-std::size_t thread_pool::hardware_capability() const {
-    return cores_;
+inline thread_pool::task_node* thread_pool::take_node(std::size_t node) {
+    mpmc_queue<task_node*>& queue = *nodes_[node];
+    task_node* task = nullptr;
+    if (!queue.try_pop(task)) {
+        return nullptr;
+    }
+
+    if (blocked_.load() > 0 && queue.size() <= queue.capacity() / 2) {
+        std::unique_lock<std::mutex> lock(space_mutex_);
+        space_.notify_all();
+    }
+
+    return task;
 }
 
+inline thread_pool::task_node* thread_pool::steal(std::size_t index) {
+    const std::size_t count = slots_.load();
+    std::uint32_t& seed = context_.seed;
+    if (seed == 0) {
+        // Seeded from the thread-local's address, distinct per thread
+        seed = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&seed) >> 4) * 2654435761u | 1u;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    // Sweeps starting at a random victim: the other workers of our node,
+    // then the other nodes' queues and workers. Threads outside the pool
+    // have no node and take from all of them.
+    task_node* task = nullptr;
+    const std::size_t home = index < queues_.size() ? queues_[index]->node : ANY_NODE;
+    const std::size_t start = count > 0 ? seed % count : 0;
+    if (home != ANY_NODE) {
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t victim = (start + k) % count;
+            if (victim != index && queues_[victim]->node == home && queues_[victim]->deque.steal(task)) {
+                counters().steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+
+    for (std::size_t k = 0; k < nodes_.size(); ++k) {
+        const std::size_t node = (seed + k) % nodes_.size();
+        if (node != home && (task = take_node(node))) {
+            return task;
+        }
+    }
+
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::size_t victim = (start + k) % count;
+        if (victim != index && queues_[victim]->node != home && queues_[victim]->deque.steal(task)) {
+            counters().steals.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+// Workers
+// Starts one more worker in the lowest free slot, unless the pool is
+// stopping or another submitter got there first
+inline void thread_pool::grow() {
+    std::unique_lock<std::mutex> lock(grow_mutex_);
+    if (stop_.load() || live_.load() >= max_threads_) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < max_threads_; ++i) {
+        if (!queues_[i]->running.load()) {
+            // A retired worker has nothing left to do but return
+            if (queues_[i]->thread.joinable()) {
+                queues_[i]->thread.join();
+            }
+            start_worker(i);
+            return;
+        }
+    }
+}
+
+// Under grow_mutex_
+inline void thread_pool::start_worker(std::size_t index) {
+    worker_queue& queue = *queues_[index];
+    queue.running.store(true);
+    live_.fetch_add(1);
+    if (slots_.load() <= index) {
+        slots_.store(index + 1);
+    }
+    queue.thread = std::thread([this, index] { worker_loop(index); });
+}
+
+// Best effort: a CPU the process may not use (cgroups, taskset) only
+// leaves the worker unpinned
+inline void thread_pool::pin_worker(std::size_t index) {
+#ifdef __linux__
+    if (pin_ == affinity::none) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pin_ == affinity::core) {
+        CPU_SET(queues_[index]->cpu, &set);
+    }
+    else {
+        for (int cpu : topology_.nodes[queues_[index]->node]) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+// Claims one of the workers above the minimum
+inline bool thread_pool::retire() {
+    std::size_t live = live_.load();
+    while (live > min_threads_) {
+        if (live_.compare_exchange_weak(live, live - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline void thread_pool::worker_loop(std::size_t index) {
+    context_ = {this, index, 0};
+    pin_worker(index);
+    while (true) {
+        task_node* task = take(index);
+        if (task) {
+            run(task);
+            continue;
+        }
+
+        // Counted but not visible yet (a submitter between its count and its
+        // push, or a lost steal race): give the CPU to whoever holds it
+        if (pending_.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const clock::time_point idle_since = timed() ? clock::now() : clock::time_point();
+
+        // Poll a while before paying for a sleep and a wake-up. A spinning
+        // worker is not idle_, so submitters skip the notify.
+        const clock::rep spin = spin_.load(std::memory_order_relaxed);
+        if (spin > 0) {
+            const clock::time_point until = clock::now() + clock::duration(spin);
+            while (pending_.load() == 0 && !stop_.load() && clock::now() < until) {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+            if (pending_.load() > 0) {
+                if (idle_since != clock::time_point()) {
+                    queues_[index]->counters.idle.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - idle_since).count(),
+                        std::memory_order_relaxed);
+                }
+                continue;
+            }
+        }
+
+        // Our deque is empty here (take() found nothing), so a worker above
+        // the minimum can exit once it has slept keep_alive_. Deciding under
+        // sleep_mutex_ with pending_ at 0 means no wake-up is meant for it.
+        idle_.fetch_add(1);
+        bool retired = false;
+        {
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            const auto ready = [this] { return stop_.load() || pending_.load() > 0; };
+            if (live_.load() > min_threads_) {
+                retired = !condition_.wait_for(lock, keep_alive_, ready) && retire();
+            }
+            else {
+                condition_.wait(lock, ready);
+            }
+        }
+        idle_.fetch_sub(1);
+        if (idle_since != clock::time_point()) {
+            queues_[index]->counters.idle.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - idle_since).count(),
+                std::memory_order_relaxed);
+        }
+
+        if (retired) {
+            queues_[index]->running.store(false);
+            return;
+        }
+
+        if (stop_.load() && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+// Process-wide pool, one worker per hardware thread, created on first use
+inline thread_pool& shared_thread_pool() {
+    static thread_pool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+    return pool;
+}
 
 #endif // THREAD_POOL_HPP
@@ -0,0 +1,153 @@
+// Contention benchmark: mpmc_queue against the mutex + condition variable
+// queue thread_pool used to have, for 1..8 producers and consumers, then the
+// pool's own throughput with external producers under each overflow policy.
+//
+// Build: g++ -std=c++17 -O2 -pthread QueueBenchmark.cpp -o QueueBenchmark
+// Usage: QueueBenchmark [items per run, default 2000000]
+#include "MpmcQueue.hpp"
+#include "Pool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The old thread_pool queue: std::queue under one mutex, consumers wait on a CV
+template <typename T>
+class mutex_queue {
+public:
+    void push(T item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            items_.push(std::move(item));
+        }
+        condition_.notify_one();
+    }
+
+    T pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !items_.empty(); });
+        T item = std::move(items_.front());
+        items_.pop();
+
+        return item;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::queue<T> items_;
+};
+
+// Millions of items per second through `queue` with the given thread counts
+template <typename Queue>
+double measure(Queue& queue, std::size_t items, std::size_t producers, std::size_t consumers) {
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> checksum(0);
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, items, producers, p] {
+            for (std::size_t i = p; i < items; i += producers) {
+                queue.push(i + 1);
+            }
+        });
+    }
+
+    // Every consumer takes an equal share; the first also takes the remainder
+    for (std::size_t c = 0; c < consumers; ++c) {
+        const std::size_t share = items / consumers + (c == 0 ? items % consumers : 0);
+        threads.emplace_back([&queue, &checksum, share] {
+            std::size_t sum = 0;
+            for (std::size_t i = 0; i < share; ++i) {
+                sum += queue.pop();
+            }
+            checksum.fetch_add(sum);
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (checksum.load() != items * (items + 1) / 2) {
+        std::cerr << "checksum mismatch\n";
+        std::exit(1);
+    }
+
+    return static_cast<double>(items) / seconds / 1e6;
+}
+
+// Millions of detached tasks per second submitted from outside the pool
+double measure_pool(thread_pool::overflow_policy policy, std::size_t items, std::size_t producers) {
+    std::atomic<std::size_t> done(0);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        thread_pool pool(std::max(1u, std::thread::hardware_concurrency()), 1024, policy);
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&pool, &done, items, producers] {
+                for (std::size_t i = 0; i < items / producers; ++i) {
+                    while (true) {
+                        try {
+                            pool.enqueue_detached([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+                            break;
+                        }
+                        catch (const std::runtime_error&) {
+                            std::this_thread::yield();   // Rejected: retry
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return static_cast<double>(done.load()) / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const std::size_t counts[] = {1, 2, 4, 8};
+
+    std::cout << "Queue throughput, Mitems/s (" << items << " items)\n"
+              << std::setw(12) << "producers" << std::setw(12) << "consumers"
+              << std::setw(14) << "mutex+cv" << std::setw(14) << "mpmc" << "\n";
+    for (std::size_t producers : counts) {
+        for (std::size_t consumers : counts) {
+            mutex_queue<std::size_t> locked;
+            mpmc_queue<std::size_t> lock_free(1024);
+            const double before = measure(locked, items, producers, consumers);
+            const double after = measure(lock_free, items, producers, consumers);
+            std::cout << std::setw(12) << producers << std::setw(12) << consumers << std::fixed << std::setprecision(2)
+                      << std::setw(14) << before << std::setw(14) << after << "\n";
+        }
+    }
+
+    const std::pair<thread_pool::overflow_policy, const char*> policies[] = {
+        {thread_pool::overflow_policy::block, "block"},
+        {thread_pool::overflow_policy::reject, "reject"},
+        {thread_pool::overflow_policy::run_in_caller, "run_in_caller"}};
+    std::cout << "\nthread_pool, capacity 1024, Mtasks/s\n"
+              << std::setw(16) << "policy" << std::setw(12) << "producers" << std::setw(14) << "throughput" << "\n";
+    for (const auto& policy : policies) {
+        for (std::size_t producers : counts) {
+            std::cout << std::setw(16) << policy.second << std::setw(12) << producers
+                      << std::setw(14) << measure_pool(policy.first, items, producers) << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+#ifndef STATISTICS_HPP
+#define STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// thread_pool's counters. Every thread that submits or runs tasks writes its
+// own block (workers one each, threads outside the pool a shared one), and
+// thread_pool::statistics() adds the blocks up when asked, so the hot path
+// never writes a cache line another worker is writing.
+
+// Log2 histogram of durations: bucket i counts samples in [2^i, 2^(i+1))
+// nanoseconds, bucket 0 also counts 0, the last one everything above
+struct latency_histogram {
+    static constexpr std::size_t BUCKETS = 40;   // Up to about 18 minutes
+
+    std::array<std::uint64_t, BUCKETS> buckets{};
+
+    static std::size_t bucket(std::chrono::nanoseconds sample);
+
+    std::uint64_t count() const;
+
+    // Upper bound of the bucket the given fraction of samples falls in
+    // (0.5 for the median, 0.99 for p99); 0 if there are no samples
+    std::chrono::nanoseconds percentile(double fraction) const;
+
+    latency_histogram& operator+=(const latency_histogram& other);
+};
+
+struct pool_statistics {
+    struct thread {
+        std::uint64_t submitted = 0;
+        std::uint64_t completed = 0;
+        std::uint64_t steals = 0;
+        std::chrono::nanoseconds busy{0};   // Running tasks (timing on)
+        std::chrono::nanoseconds idle{0};   // Spinning or asleep (timing on)
+    };
+
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t steals = 0;
+    std::size_t pending = 0;              // Queued now
+    std::size_t pending_high_water = 0;
+    std::vector<thread> workers;          // By worker slot
+    thread outside;                       // Threads outside the pool, together
+    latency_histogram wait;               // Submission to start (timing on)
+    latency_histogram run;                // Run time (timing on)
+};
+
+namespace detail {
+
+    struct atomic_histogram {
+        std::array<std::atomic<std::uint64_t>, latency_histogram::BUCKETS> buckets{};
+
+        void record(std::chrono::nanoseconds sample) {
+            buckets[latency_histogram::bucket(sample)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void add_to(latency_histogram& histogram) const {
+            for (std::size_t i = 0; i < latency_histogram::BUCKETS; ++i) {
+                histogram.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        void reset() {
+            for (std::atomic<std::uint64_t>& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // One task run, nanoseconds since the trace started
+    struct trace_span {
+        const char* label;
+        std::int64_t start;
+        std::int64_t duration;
+        std::int64_t wait;   // -1 if the task was not timestamped when submitted
+    };
+
+    // Cache-line aligned so neighbouring blocks do not false-share
+    struct alignas(64) thread_counters {
+        std::atomic<std::uint64_t> submitted{0};
+        std::atomic<std::uint64_t> completed{0};
+        std::atomic<std::uint64_t> steals{0};
+        std::atomic<std::int64_t> busy{0};   // Nanoseconds
+        std::atomic<std::int64_t> idle{0};
+        atomic_histogram wait;
+        atomic_histogram run;
+
+        std::mutex trace_mutex;
+        std::vector<trace_span> trace;
+
+        void add_to(pool_statistics::thread& thread) const {
+            thread.submitted = submitted.load(std::memory_order_relaxed);
+            thread.completed = completed.load(std::memory_order_relaxed);
+            thread.steals = steals.load(std::memory_order_relaxed);
+            thread.busy = std::chrono::nanoseconds(busy.load(std::memory_order_relaxed));
+            thread.idle = std::chrono::nanoseconds(idle.load(std::memory_order_relaxed));
+        }
+
+        void reset() {
+            submitted.store(0, std::memory_order_relaxed);
+            completed.store(0, std::memory_order_relaxed);
+            steals.store(0, std::memory_order_relaxed);
+            busy.store(0, std::memory_order_relaxed);
+            idle.store(0, std::memory_order_relaxed);
+            wait.reset();
+            run.reset();
+        }
+    };
+
+    // Microseconds with nanosecond digits, as the trace format wants
+    inline void write_microseconds(std::ostream& out, std::int64_t nanoseconds) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%lld.%03lld", static_cast<long long>(nanoseconds / 1000),
+                      static_cast<long long>(nanoseconds % 1000));
+        out << buffer;
+    }
+
+    inline void write_json_string(std::ostream& out, const char* text) {
+        out << '"';
+        for (; *text; ++text) {
+            const unsigned char c = static_cast<unsigned char>(*text);
+            if (c == '"' || c == '\\') {
+                out << '\\' << *text;
+            }
+            else if (c < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out << buffer;
+            }
+            else {
+                out << *text;
+            }
+        }
+        out << '"';
+    }
+
+    // Chrome trace event format: one complete ("X") event per span, and a
+    // name for every thread that has any; load in chrome://tracing or Perfetto
+    inline void write_chrome_trace(std::ostream& out, const std::vector<std::vector<trace_span>>& threads,
+                                   const std::vector<const char*>& names) {
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (std::size_t tid = 0; tid < threads.size(); ++tid) {
+            if (threads[tid].empty()) {
+                continue;
+            }
+
+            out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"name\":";
+            write_json_string(out, names[tid]);
+            out << "}}";
+            first = false;
+
+            for (const trace_span& span : threads[tid]) {
+                out << ",\n{\"name\":";
+                write_json_string(out, span.label ? span.label : "task");
+                out << ",\"cat\":\"thread_pool\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                write_microseconds(out, span.start);
+                out << ",\"dur\":";
+                write_microseconds(out, span.duration);
+                if (span.wait >= 0) {
+                    out << ",\"args\":{\"wait_us\":";
+                    write_microseconds(out, span.wait);
+                    out << "}";
+                }
+                out << "}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+} // namespace detail
+
+inline std::size_t latency_histogram::bucket(std::chrono::nanoseconds sample) {
+    std::uint64_t ns = sample.count() > 0 ? static_cast<std::uint64_t>(sample.count()) : 0;
+    std::size_t index = 0;
+    while (ns > 1 && index + 1 < BUCKETS) {
+        ns >>= 1;
+        ++index;
+    }
+
+    return index;
+}
+
+inline std::uint64_t latency_histogram::count() const {
+    std::uint64_t total = 0;
+    for (std::uint64_t samples : buckets) {
+        total += samples;
+    }
+
+    return total;
+}
+
+inline std::chrono::nanoseconds latency_histogram::percentile(double fraction) const {
+    const std::uint64_t total = count();
+    if (total == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    const double target = fraction * static_cast<double>(total);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (static_cast<double>(seen) >= target && seen > 0) {
+            return std::chrono::nanoseconds(std::int64_t(1) << (i + 1));
+        }
+    }
+
+    return std::chrono::nanoseconds(std::int64_t(1) << BUCKETS);
+}
+
+inline latency_histogram& latency_histogram::operator+=(const latency_histogram& other) {
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+
+    return *this;
+}
+
+#endif // STATISTICS_HPP
@@ -0,0 +1,139 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include "BlockPool.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only void() callable with a small buffer: closures up to INLINE_SIZE
+// bytes that are nothrow-movable live inside the task, larger ones in a
+// block_pool block. Unlike std::function it takes move-only closures (a
+// promise, a unique_ptr) and never copies them.
+class task {
+public:
+    static constexpr std::size_t INLINE_SIZE = 6 * sizeof(void*);
+
+    task() noexcept = default;
+
+    template <typename Func, typename = typename std::enable_if<!std::is_same<typename std::decay<Func>::type, task>::value>::type>
+    task(Func&& func);
+
+    task(task&& other) noexcept;
+    task& operator=(task&& other) noexcept;
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    ~task();
+
+    void operator()();
+    explicit operator bool() const noexcept;
+
+private:
+    struct operations {
+        void (*invoke)(void* storage);
+        void (*move)(void* to, void* from) noexcept;  // Leaves `from` destroyed
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    // Closure stored in the buffer itself
+    template <typename Func>
+    struct inline_operations {
+        static void invoke(void* storage) { (*static_cast<Func*>(storage))(); }
+        static void move(void* to, void* from) noexcept {
+            ::new (to) Func(std::move(*static_cast<Func*>(from)));
+            static_cast<Func*>(from)->~Func();
+        }
+        static void destroy(void* storage) noexcept { static_cast<Func*>(storage)->~Func(); }
+
+        static constexpr operations table{&invoke, &move, &destroy};
+    };
+
+    // Buffer holds a pointer to the closure
+    template <typename Func>
+    struct pooled_operations {
+        static Func*& get(void* storage) { return *static_cast<Func**>(storage); }
+        static void invoke(void* storage) { (*get(storage))(); }
+        static void move(void* to, void* from) noexcept { ::new (to) Func*(get(from)); }
+        static void destroy(void* storage) noexcept {
+            get(storage)->~Func();
+            pool_allocator<Func>().deallocate(get(storage), 1);
+        }
+
+        static constexpr operations table{&invoke, &move, &destroy};
+    };
+
+    template <typename Func>
+    static constexpr bool fits_inline() {
+        return sizeof(Func) <= INLINE_SIZE
+            && alignof(Func) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible<Func>::value;
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const operations* operations_ = nullptr;
+};
+
+template <typename Func>
+constexpr task::operations task::inline_operations<Func>::table;
+
+template <typename Func>
+constexpr task::operations task::pooled_operations<Func>::table;
+
+// Constructor
+template <typename Func, typename>
+task::task(Func&& func) {
+    using closure_type = typename std::decay<Func>::type;
+    if constexpr (fits_inline<closure_type>()) {
+        ::new (static_cast<void*>(storage_)) closure_type(std::forward<Func>(func));
+        operations_ = &inline_operations<closure_type>::table;
+    }
+    else {
+        pool_allocator<closure_type> allocator;
+        closure_type* closure = allocator.allocate(1);
+        try {
+            ::new (static_cast<void*>(closure)) closure_type(std::forward<Func>(func));
+        }
+        catch (...) {
+            allocator.deallocate(closure, 1);
+            throw;
+        }
+        ::new (static_cast<void*>(storage_)) closure_type*(closure);
+        operations_ = &pooled_operations<closure_type>::table;
+    }
+}
+
+inline task::task(task&& other) noexcept : operations_(other.operations_) {
+    if (operations_) {
+        operations_->move(storage_, other.storage_);
+        other.operations_ = nullptr;
+    }
+}
+
+inline task& task::operator=(task&& other) noexcept {
+    if (this != &other) {
+        this->~task();
+        ::new (static_cast<void*>(this)) task(std::move(other));
+    }
+
+    return *this;
+}
+
+// Destructor
+inline task::~task() {
+    if (operations_) {
+        operations_->destroy(storage_);
+        operations_ = nullptr;
+    }
+}
+
+inline void task::operator()() {
+    operations_->invoke(storage_);
+}
+
+inline task::operator bool() const noexcept {
+    return operations_ != nullptr;
+}
+
+#endif // TASK_HPP
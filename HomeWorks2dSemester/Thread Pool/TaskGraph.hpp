@@ -0,0 +1,540 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "Pool.hpp"
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Dependent work on a thread_pool without blocking workers. Two layers:
+//
+//  - task_handle<T>: result of spawn(), with then() continuations and
+//    when_all() / when_any() joins. A continuation is queued on the pool by
+//    whichever thread completes its antecedent; nothing waits on a future.
+//  - task_graph: explicit nodes and precede() edges, run as a whole. A node
+//    is queued when the atomic count of its unfinished predecessors drops to
+//    zero; the finishing thread runs one released successor itself.
+//
+// get(), wait() and task_graph::run() help with pool work while they wait,
+// so they are safe to call from inside pool tasks.
+
+namespace detail {
+
+    struct continuation {
+        task work;
+        continuation* next;
+    };
+
+    // Completion shared by a task and its handles. Continuations wait on an
+    // intrusive stack that complete() swaps for a sentinel, so one added
+    // after completion sees the sentinel and is queued right away.
+    class graph_state_base {
+    public:
+        explicit graph_state_base(thread_pool& pool) : pool_(pool), continuations_(nullptr) {}
+        virtual ~graph_state_base();
+
+        graph_state_base(const graph_state_base&) = delete;
+        graph_state_base& operator=(const graph_state_base&) = delete;
+
+        thread_pool& pool() const { return pool_; }
+        bool ready() const { return continuations_.load(std::memory_order_acquire) == closed(); }
+        const std::exception_ptr& error() const { return error_; }
+
+        // Queues func on the pool once this state is ready
+        template <typename Func>
+        void on_ready(Func&& func);
+
+        void fail(std::exception_ptr error);
+
+    protected:
+        void complete();
+
+    private:
+        static continuation* closed();
+
+        thread_pool& pool_;
+        std::atomic<continuation*> continuations_;
+        std::exception_ptr error_;
+    };
+
+    template <typename T>
+    class graph_state : public graph_state_base {
+    public:
+        using graph_state_base::graph_state_base;
+
+        void set_value(T value) {
+            value_.emplace(std::move(value));
+            complete();
+        }
+
+        const T& value() const { return *value_; }
+
+    private:
+        std::optional<T> value_;
+    };
+
+    template <>
+    class graph_state<void> : public graph_state_base {
+    public:
+        using graph_state_base::graph_state_base;
+
+        void set_value() { complete(); }
+    };
+
+    template <typename T>
+    std::shared_ptr<graph_state<T>> make_state(thread_pool& pool) {
+        return std::allocate_shared<graph_state<T>>(pool_allocator<graph_state<T>>(), pool);
+    }
+
+    // Runs func and stores its result or exception in state
+    template <typename T, typename Func, typename... Args>
+    void fulfil(graph_state<T>& state, Func& func, Args&&... args) {
+        try {
+            if constexpr (std::is_void<T>::value) {
+                std::invoke(func, std::forward<Args>(args)...);
+                state.set_value();
+            }
+            else {
+                state.set_value(std::invoke(func, std::forward<Args>(args)...));
+            }
+        }
+        catch (...) {
+            state.fail(std::current_exception());
+        }
+    }
+
+    template <typename T, typename Func>
+    struct continuation_result {
+        using type = typename std::invoke_result<Func&, const T&>::type;
+    };
+
+    template <typename Func>
+    struct continuation_result<void, Func> {
+        using type = typename std::invoke_result<Func&>::type;
+    };
+
+    // Calls finish() once every input is ready
+    template <typename Finish>
+    void when_ready(std::vector<std::shared_ptr<graph_state_base>> inputs, Finish finish);
+
+} // namespace detail
+
+template <typename T>
+class task_handle {
+public:
+    using value_type = T;
+
+    task_handle() = default;
+
+    bool valid() const { return static_cast<bool>(state_); }
+    bool ready() const { return state_->ready(); }
+
+    // Runs other pool tasks until this one is done
+    void wait() const;
+
+    // const T& (nothing for void); rethrows the task's exception
+    decltype(auto) get() const;
+
+    // A task running func on this one's value (no argument for void) once
+    // it is ready. If this task failed, func is skipped and the returned
+    // handle carries the same exception.
+    template <typename Func>
+    auto then(Func&& func) const -> task_handle<typename detail::continuation_result<T, typename std::decay<Func>::type>::type>;
+
+private:
+    explicit task_handle(std::shared_ptr<detail::graph_state<T>> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<detail::graph_state<T>> state_;
+
+    template <typename U>
+    friend class task_handle;
+
+    template <typename Func>
+    friend auto spawn(thread_pool& pool, Func&& func) -> task_handle<typename std::invoke_result<typename std::decay<Func>::type&>::type>;
+
+    template <typename U>
+    friend auto when_all(thread_pool& pool, const std::vector<task_handle<U>>& handles)
+        -> task_handle<typename std::conditional<std::is_void<U>::value, void, std::vector<U>>::type>;
+
+    template <typename... Ts>
+    friend task_handle<void> when_all(thread_pool& pool, const task_handle<Ts>&... handles);
+
+    template <typename U>
+    friend task_handle<std::size_t> when_any(thread_pool& pool, const std::vector<task_handle<U>>& handles);
+};
+
+// Shared state
+inline detail::graph_state_base::~graph_state_base() {
+    // Never completed: the continuations will not run
+    continuation* node = continuations_.load(std::memory_order_relaxed);
+    while (node && node != closed()) {
+        continuation* next = node->next;
+        node->~continuation();
+        block_pool::deallocate(node, sizeof(continuation));
+        node = next;
+    }
+}
+
+template <typename Func>
+void detail::graph_state_base::on_ready(Func&& func) {
+    continuation* head = continuations_.load(std::memory_order_acquire);
+    if (head == closed()) {
+        pool_.enqueue_detached(std::forward<Func>(func));
+        return;
+    }
+
+    void* memory = block_pool::allocate(sizeof(continuation));
+    continuation* node = ::new (memory) continuation{task(std::forward<Func>(func)), head};
+    while (!continuations_.compare_exchange_weak(node->next, node, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        if (node->next == closed()) {
+            pool_.enqueue_detached(std::move(node->work));
+            node->~continuation();
+            block_pool::deallocate(node, sizeof(continuation));
+            return;
+        }
+    }
+}
+
+inline void detail::graph_state_base::fail(std::exception_ptr error) {
+    error_ = std::move(error);
+    complete();
+}
+
+inline void detail::graph_state_base::complete() {
+    continuation* node = continuations_.exchange(closed(), std::memory_order_acq_rel);
+    while (node) {
+        continuation* next = node->next;
+        pool_.enqueue_detached(std::move(node->work));
+        node->~continuation();
+        block_pool::deallocate(node, sizeof(continuation));
+        node = next;
+    }
+}
+
+inline detail::continuation* detail::graph_state_base::closed() {
+    static continuation sentinel{task(), nullptr};
+
+    return &sentinel;
+}
+
+template <typename Finish>
+void detail::when_ready(std::vector<std::shared_ptr<graph_state_base>> inputs, Finish finish) {
+    if (inputs.empty()) {
+        finish();
+        return;
+    }
+
+    // The last input to finish runs finish()
+    struct join {
+        std::atomic<std::size_t> remaining;
+        Finish finish;
+
+        join(std::size_t count, Finish&& func) : remaining(count), finish(std::move(func)) {}
+    };
+    auto shared = std::allocate_shared<join>(pool_allocator<join>(), inputs.size(), std::move(finish));
+    for (const auto& input : inputs) {
+        input->on_ready([shared] {
+            if (shared->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                shared->finish();
+            }
+        });
+    }
+}
+
+// Handles
+template <typename T>
+void task_handle<T>::wait() const {
+    detail::help_until(state_->pool(), [this] { return state_->ready(); });
+}
+
+template <typename T>
+decltype(auto) task_handle<T>::get() const {
+    wait();
+    if (state_->error()) {
+        std::rethrow_exception(state_->error());
+    }
+
+    if constexpr (!std::is_void<T>::value) {
+        return (state_->value());
+    }
+}
+
+template <typename T>
+template <typename Func>
+auto task_handle<T>::then(Func&& func) const
+    -> task_handle<typename detail::continuation_result<T, typename std::decay<Func>::type>::type> {
+
+    using result_type = typename detail::continuation_result<T, typename std::decay<Func>::type>::type;
+
+    auto result = detail::make_state<result_type>(state_->pool());
+    state_->on_ready([input = state_, result, func = std::forward<Func>(func)]() mutable {
+        if (input->error()) {
+            result->fail(input->error());
+        }
+        else if constexpr (std::is_void<T>::value) {
+            detail::fulfil(*result, func);
+        }
+        else {
+            detail::fulfil(*result, func, input->value());
+        }
+    });
+
+    return task_handle<result_type>(std::move(result));
+}
+
+// Runs func on the pool
+template <typename Func>
+auto spawn(thread_pool& pool, Func&& func) -> task_handle<typename std::invoke_result<typename std::decay<Func>::type&>::type> {
+    using result_type = typename std::invoke_result<typename std::decay<Func>::type&>::type;
+
+    auto result = detail::make_state<result_type>(pool);
+    pool.enqueue_detached([result, func = std::forward<Func>(func)]() mutable {
+        detail::fulfil(*result, func);
+    });
+
+    return task_handle<result_type>(std::move(result));
+}
+
+// Ready when every handle is; holds their values in order, or the first
+// failed handle's exception
+template <typename T>
+auto when_all(thread_pool& pool, const std::vector<task_handle<T>>& handles)
+    -> task_handle<typename std::conditional<std::is_void<T>::value, void, std::vector<T>>::type> {
+
+    using result_type = typename std::conditional<std::is_void<T>::value, void, std::vector<T>>::type;
+
+    auto result = detail::make_state<result_type>(pool);
+    std::vector<std::shared_ptr<detail::graph_state_base>> inputs;
+    inputs.reserve(handles.size());
+    for (const auto& handle : handles) {
+        inputs.push_back(handle.state_);
+    }
+
+    detail::when_ready(inputs, [result, handles] {
+        for (const auto& handle : handles) {
+            if (handle.state_->error()) {
+                result->fail(handle.state_->error());
+                return;
+            }
+        }
+
+        if constexpr (std::is_void<T>::value) {
+            result->set_value();
+        }
+        else {
+            std::vector<T> values;
+            values.reserve(handles.size());
+            for (const auto& handle : handles) {
+                values.push_back(handle.state_->value());
+            }
+            result->set_value(std::move(values));
+        }
+    });
+
+    return task_handle<result_type>(std::move(result));
+}
+
+// Ready when every handle is, whatever their types; fails like the vector form
+template <typename... Ts>
+task_handle<void> when_all(thread_pool& pool, const task_handle<Ts>&... handles) {
+    auto result = detail::make_state<void>(pool);
+    std::vector<std::shared_ptr<detail::graph_state_base>> inputs{handles.state_...};
+    detail::when_ready(inputs, [result, inputs] {
+        for (const auto& input : inputs) {
+            if (input->error()) {
+                result->fail(input->error());
+                return;
+            }
+        }
+        result->set_value();
+    });
+
+    return task_handle<void>(std::move(result));
+}
+
+// Index of the first handle to become ready, failed or not
+template <typename T>
+task_handle<std::size_t> when_any(thread_pool& pool, const std::vector<task_handle<T>>& handles) {
+    if (handles.empty()) {
+        throw std::invalid_argument("when_any of no tasks");
+    }
+
+    auto result = detail::make_state<std::size_t>(pool);
+    auto claimed = std::allocate_shared<std::atomic<bool>>(pool_allocator<std::atomic<bool>>(), false);
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        handles[i].state_->on_ready([result, claimed, i] {
+            if (!claimed->exchange(true, std::memory_order_acq_rel)) {
+                result->set_value(i);
+            }
+        });
+    }
+
+    return task_handle<std::size_t>(std::move(result));
+}
+
+// Task graph
+class task_graph {
+public:
+    using node_id = std::size_t;
+
+    task_graph() = default;
+    task_graph(const task_graph&) = delete;
+    task_graph& operator=(const task_graph&) = delete;
+
+    // func: void(); kept, so the graph can be run again
+    template <typename Func>
+    node_id add(Func&& func);
+
+    // `after` starts only once `before` has finished
+    void precede(node_id before, node_id after);
+
+    // Runs every node, helping until all are done. After a node throws, the
+    // nodes not yet started are skipped and the first exception is rethrown.
+    // Throws std::logic_error if the edges form a cycle.
+    void run(thread_pool& pool);
+
+    std::size_t size() const;
+
+private:
+    struct node {
+        task work;
+        std::vector<node_id> successors;
+        std::size_t dependencies;
+    };
+
+    std::vector<node> nodes_;
+    bool checked_ = false;
+
+    // Per run
+    std::unique_ptr<std::atomic<std::size_t>[]> remaining_;
+    std::atomic<std::size_t> unfinished_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+
+    void check_acyclic();
+    void run_from(thread_pool& pool, node_id id);
+};
+
+template <typename Func>
+task_graph::node_id task_graph::add(Func&& func) {
+    nodes_.push_back(node{task(std::forward<Func>(func)), {}, 0});
+    checked_ = false;
+
+    return nodes_.size() - 1;
+}
+
+inline void task_graph::precede(node_id before, node_id after) {
+    if (before >= nodes_.size() || after >= nodes_.size()) {
+        throw std::out_of_range("task_graph node out of range");
+    }
+
+    nodes_[before].successors.push_back(after);
+    ++nodes_[after].dependencies;
+    checked_ = false;
+}
+
+inline void task_graph::run(thread_pool& pool) {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    if (!checked_) {
+        check_acyclic();
+    }
+
+    remaining_.reset(new std::atomic<std::size_t>[nodes_.size()]);
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        remaining_[i].store(nodes_[i].dependencies, std::memory_order_relaxed);
+    }
+    unfinished_.store(nodes_.size());
+    failed_.store(false);
+    error_ = nullptr;
+
+    for (node_id id = 0; id < nodes_.size(); ++id) {
+        if (nodes_[id].dependencies == 0) {
+            pool.enqueue_detached([this, &pool, id] { run_from(pool, id); });
+        }
+    }
+
+    detail::help_until(pool, [this] { return unfinished_.load(std::memory_order_acquire) == 0; });
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+inline std::size_t task_graph::size() const {
+    return nodes_.size();
+}
+
+// Kahn's algorithm: every node must be reachable by removing finished ones
+inline void task_graph::check_acyclic() {
+    std::vector<std::size_t> remaining(nodes_.size());
+    std::vector<node_id> ready;
+    for (node_id id = 0; id < nodes_.size(); ++id) {
+        remaining[id] = nodes_[id].dependencies;
+        if (remaining[id] == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+        const node_id id = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (node_id next : nodes_[id].successors) {
+            if (--remaining[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+
+    if (visited != nodes_.size()) {
+        throw std::logic_error("task_graph has a cycle");
+    }
+    checked_ = true;
+}
+
+// Runs a node, queues all released successors but one and carries on with that one
+inline void task_graph::run_from(thread_pool& pool, node_id id) {
+    while (true) {
+        if (!failed_.load(std::memory_order_relaxed)) {
+            try {
+                nodes_[id].work();
+            }
+            catch (...) {
+                if (!failed_.exchange(true)) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+
+        constexpr node_id NONE = static_cast<node_id>(-1);
+        node_id next = NONE;
+        for (node_id successor : nodes_[id].successors) {
+            if (remaining_[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+
+            if (next != NONE) {
+                pool.enqueue_detached([this, &pool, next] { run_from(pool, next); });
+            }
+            next = successor;
+        }
+
+        unfinished_.fetch_sub(1, std::memory_order_acq_rel);
+        if (next == NONE) {
+            return;
+        }
+        id = next;
+    }
+}
+
+#endif // TASK_GRAPH_HPP
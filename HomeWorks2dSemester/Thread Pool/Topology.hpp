@@ -0,0 +1,107 @@
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// The CPUs of each NUMA node this process may run on. Read from sysfs on
+// Linux, restricted to the process's affinity mask (containers and taskset
+// hide CPUs that sysfs still lists); nodes left without CPUs are dropped.
+// Elsewhere, or if sysfs is unreadable, one node with every hardware thread.
+struct cpu_topology {
+    std::vector<std::vector<int>> nodes;
+
+    // Detected once per process
+    static const cpu_topology& current();
+
+    static cpu_topology detect();
+};
+
+namespace detail {
+
+    // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+    inline std::vector<int> parse_cpu_list(const std::string& list) {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+
+            const std::size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        return cpus;
+    }
+
+} // namespace detail
+
+inline const cpu_topology& cpu_topology::current() {
+    static const cpu_topology topology = detect();
+
+    return topology;
+}
+
+inline cpu_topology cpu_topology::detect() {
+    cpu_topology topology;
+
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool masked = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file.is_open()) {
+            break;
+        }
+
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus;
+        try {
+            cpus = detail::parse_cpu_list(list);
+        }
+        catch (const std::exception&) {
+            continue;   // Malformed: treat the node as empty
+        }
+
+        if (masked) {
+            cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&allowed](int cpu) {
+                return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed);
+            }), cpus.end());
+        }
+        if (!cpus.empty()) {
+            topology.nodes.push_back(std::move(cpus));
+        }
+    }
+#endif
+
+    if (topology.nodes.empty()) {
+        std::vector<int> cpus(std::max(1u, std::thread::hardware_concurrency()));
+        for (std::size_t i = 0; i < cpus.size(); ++i) {
+            cpus[i] = static_cast<int>(i);
+        }
+        topology.nodes.push_back(std::move(cpus));
+    }
+
+    return topology;
+}
+
+#endif // TOPOLOGY_HPP
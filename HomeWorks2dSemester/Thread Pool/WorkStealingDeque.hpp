@@ -0,0 +1,149 @@
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque (the C11 formulation of Le, Pop, Cohen and
+// Zappa Nardelli). The owner thread pushes and pops at the bottom (LIFO);
+// any other thread steals from the top (FIFO). Only a steal racing the owner
+// for the last item needs a CAS. The ring grows by doubling; outgrown rings
+// stay alive until the deque is destroyed, since a thief may still read one.
+template <typename T>
+class work_stealing_deque {
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+public:
+    explicit work_stealing_deque(std::size_t capacity = 1024);
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    // Owner only
+    void push(T item);
+    bool pop(T& item);
+
+    // Any thread
+    bool steal(T& item);
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    struct ring {
+        std::int64_t capacity;
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit ring(std::int64_t cap)
+            : capacity(cap), mask(cap - 1), items(new std::atomic<T>[static_cast<std::size_t>(cap)]) {}
+
+        T load(std::int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void store(std::int64_t i, T item) { items[i & mask].store(item, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    alignas(64) std::atomic<ring*> ring_;
+    std::vector<std::unique_ptr<ring>> rings_;  // Current ring last; owner only
+
+    ring* grow(ring* old, std::int64_t bottom, std::int64_t top);
+};
+
+// Constructor
+template <typename T>
+work_stealing_deque<T>::work_stealing_deque(std::size_t capacity)
+    : top_(0), bottom_(0) {
+    std::int64_t cap = 1;
+    while (cap < static_cast<std::int64_t>(capacity)) {
+        cap <<= 1;
+    }
+
+    rings_.emplace_back(new ring(cap));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+}
+
+// Push (owner)
+template <typename T>
+void work_stealing_deque<T>::push(T item) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+    if (b - t > r->capacity - 1) {
+        r = grow(r, b, t);
+    }
+
+    r->store(b, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+// Pop (owner)
+template <typename T>
+bool work_stealing_deque<T>::pop(T& item) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item = r->load(b);
+    if (t == b) {
+        // Last item: race the thieves for it
+        const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    return true;
+}
+
+// Steal (any thread)
+template <typename T>
+bool work_stealing_deque<T>::steal(T& item) {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+        return false;
+    }
+
+    ring* r = ring_.load(std::memory_order_acquire);
+    item = r->load(t);
+
+    return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool work_stealing_deque<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+std::size_t work_stealing_deque<T>::size() const {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_relaxed);
+
+    return b > t ? static_cast<std::size_t>(b - t) : 0;
+}
+
+template <typename T>
+typename work_stealing_deque<T>::ring* work_stealing_deque<T>::grow(ring* old, std::int64_t bottom, std::int64_t top) {
+    rings_.emplace_back(new ring(old->capacity * 2));
+    ring* r = rings_.back().get();
+    for (std::int64_t i = top; i < bottom; ++i) {
+        r->store(i, old->load(i));
+    }
+    ring_.store(r, std::memory_order_release);
+
+    return r;
+}
+
+#endif // WORK_STEALING_DEQUE_HPP
@@ -1,10 +1,12 @@
 #include "../include/file_reader.hpp"
+#include "Pool.hpp"
+#include "Parallel.hpp"
 
 void file_reader::read(const std::vector<std::string> &paths, bool recursive, const std::vector<std::string> &include_extensions, function_type line_callback)
 {
     namespace fs = std::filesystem;
     std::mutex mutex;
-    std::vector<std::thread> threads;
+    std::vector<std::string> files;
     for (const auto& path : paths) {
         fs::path p(path);
         if (!fs::exists(p)) {
@@ -16,12 +18,12 @@ void file_reader::read(const std::vector<std::string> &paths, bool recursive, co
         if (fs::is_directory(p) && recursive) {
             for (const auto& entry : fs::recursive_directory_iterator(p, fs::directory_options::skip_permission_denied)) {
                 if (fs::is_regular_file(entry.path()) && matches_extension(entry.path().string(), include_extensions)) {
-                    threads.emplace_back(process_file, fs::absolute(entry.path()).string(), line_callback, std::ref(mutex));
+                    files.push_back(fs::absolute(entry.path()).string());
                 }
             }
         }
         else if (fs::is_regular_file(p) && matches_extension(p.string(), include_extensions)) {
-            threads.emplace_back(process_file, fs::absolute(p).string(), line_callback, std::ref(mutex));
+            files.push_back(fs::absolute(p).string());
         }
         else if (!fs::is_directory(p)) {
             std::lock_guard<std::mutex> lock(mutex);
@@ -29,9 +31,14 @@ void file_reader::read(const std::vector<std::string> &paths, bool recursive, co
         }
     }
 
-    for (auto& t : threads) {
-        t.join();
-    }
+    // One file per task; this thread scans files too
+    const unsigned int cores = std::max(2u, std::thread::hardware_concurrency());
+    thread_pool pool(cores - 1);
+    parallel_for(pool, std::size_t(0), files.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            process_file(files[i], line_callback, mutex);
+        }
+    });
 }
 
 void file_reader::process_file(const std::string &filepath, function_type callback, std::mutex &mutex)
@@ -43,12 +50,24 @@ void file_reader::process_file(const std::string &filepath, function_type callba
         return;
     }
 
-    std::string line;
+    // Lines are read without the lock and handed over in bounded batches:
+    // memory stays flat on huge files, and each batch reaches the callback
+    // together
+    constexpr std::size_t batch_size = 1024;
+    std::vector<std::string> batch(batch_size);
     std::size_t line_number = 0;
-    while (std::getline(file, line)) {
-        ++line_number;
+    bool more = true;
+    while (more) {
+        std::size_t count = 0;
+        while (count < batch_size && std::getline(file, batch[count])) {
+            ++count;
+        }
+        more = count == batch_size;
+
         std::lock_guard<std::mutex> lock(mutex);
-        callback(filepath, line, line_number);
+        for (std::size_t i = 0; i < count; ++i) {
+            callback(filepath, batch[i], ++line_number);
+        }
     }
 
     file.close();